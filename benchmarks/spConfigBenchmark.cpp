@@ -0,0 +1,326 @@
+/**
+ * benchmarks for spConfig library
+ * 
+ * files are kept in an spConfigMemoryStorage, so results do not depend on the disk, and generated 
+ * by spConfigCorpus, so they are the same on every machine
+ * 
+ * usage:
+ *   spConfigBenchmark [--max-size <bytes>] [--no-autosave]
+ *   spConfigBenchmark --corpus <file> <bytes>   writes a generated file for use elsewhere
+ * 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <spConfig.h>
+#include "spConfigCorpus.h"
+
+
+// files read and written by the benchmarks
+#define BENCH_PATH  "/bench"
+#define BENCH_FILE  "/bench/config.ini"
+
+// minimum time to repeat a throughput benchmark for
+#define BENCH_MIN_NS  200000000.0
+
+static volatile int64_t sink;
+
+
+/**
+ * @brief return the average time of calls to a function
+ * 
+ * @param iterations  number of calls
+ * @param f  function called with the number of the call
+ * @return double  ns per call
+ */
+template <class F> double nsPerCall(size_t iterations, F f)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++)
+  {
+    f(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+/**
+ * @brief return the average time of calls to a function, repeated until BENCH_MIN_NS passed
+ * 
+ * @param f  function
+ * @return double  ns per call
+ */
+template <class F> double nsPerRun(F f)
+{
+  size_t runs = 0;
+  auto start = std::chrono::steady_clock::now();
+  double ns = 0;
+  do
+  {
+    f();
+    runs++;
+    ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  } while (ns < BENCH_MIN_NS);
+  return ns / runs;
+}
+
+void report(const char* name, double ns)
+{
+  printf("%-48s %12.1f ns/op\n", name, ns);
+}
+
+void reportThroughput(const char* name, size_t bytes, double ns)
+{
+  printf("%-48s %12.1f MB/s  (%.3f ms)\n", name, bytes / ns * 1000.0, ns / 1000000.0);
+}
+
+std::string sizeName(size_t bytes)
+{
+  char buf[32];
+  if (bytes >= 1024 * 1024)
+  {
+    snprintf(buf, sizeof(buf), "%u MB", (unsigned int)(bytes / (1024 * 1024)));
+  }
+  else
+  {
+    snprintf(buf, sizeof(buf), "%u KB", (unsigned int)(bytes / 1024));
+  }
+  return buf;
+}
+
+
+/**
+ * @brief getters and setters on a 64 KB file, hits and misses by name and by spConfigKey
+ * 
+ */
+void benchAccess(spConfigMemoryStorage &storage)
+{
+  spConfigCorpus corpus;
+  size_t sections;
+  std::string content = corpus.generate(64 * 1024, sections);
+  storage.setFile(BENCH_FILE, content.data(), content.length());
+  spConfig config;
+  config.setStorage(&storage);
+  config.setConfigFilePath(BENCH_PATH);
+  config.read();
+
+  // names of random entries, picked the same way on every machine
+  const size_t count = 1024;
+  std::vector<std::string> sectionNames, keyNames;
+  spConfigCorpus pick(7);
+  for (size_t i = 0; i < count; i++)
+  {
+    uint64_t r = pick.next();
+    sectionNames.push_back(spConfigCorpus::section(r % sections));
+    keyNames.push_back(spConfigCorpus::key((r >> 32) % SPCONFIG_CORPUS_KEYS));
+  }
+  std::vector<spConfigKey> keys, missingKeys;
+  for (size_t i = 0; i < count; i++)
+  {
+    keys.push_back(spConfigKey(sectionNames[i].c_str(), keyNames[i].c_str()));
+    missingKeys.push_back(spConfigKey(sectionNames[i].c_str(), "missing"));
+  }
+  const size_t iterations = 1000000;
+
+  printf("\naccess, %u values\n", (unsigned int)(sections * SPCONFIG_CORPUS_KEYS));
+  report("getInt32() hit by name", nsPerCall(iterations, [&](size_t i) {
+    sink = config.getInt32(sectionNames[i % count].c_str(), keyNames[i % count].c_str());
+  }));
+  report("getInt32() hit by spConfigKey", nsPerCall(iterations, [&](size_t i) {
+    sink = config.getInt32(keys[i % count]);
+  }));
+  report("getInt32() miss by name", nsPerCall(iterations, [&](size_t i) {
+    sink = config.getInt32(sectionNames[i % count].c_str(), "missing", 1);
+  }));
+  report("getInt32() miss by spConfigKey", nsPerCall(iterations, [&](size_t i) {
+    sink = config.getInt32(missingKeys[i % count], 1);
+  }));
+  report("getCStr() hit by spConfigKey", nsPerCall(iterations, [&](size_t i) {
+    sink = (intptr_t)config.getCStr(keys[i % count]);
+  }));
+  report("getString() hit by spConfigKey", nsPerCall(iterations, [&](size_t i) {
+    sink = config.getString(keys[i % count]).length();
+  }));
+
+  std::vector<std::string> values;
+  for (size_t i = 0; i < count; i++)
+  {
+    values.push_back(config.getString(keys[i]));
+  }
+  report("setValue() without change", nsPerCall(iterations, [&](size_t i) {
+    config.setValue(keys[i % count], values[i % count].c_str());
+  }));
+  report("setValue() with change", nsPerCall(iterations, [&](size_t i) {
+    config.setValue(keys[i % count], (int32_t)i);
+  }));
+}
+
+/**
+ * @brief conversions of spConfigValue
+ * 
+ */
+void benchValue()
+{
+  const size_t iterations = 1000000;
+  spConfigValue intValue("-123456");
+  spConfigValue doubleValue("3.14159");
+  spConfigValue boolValue("true");
+
+  printf("\nspConfigValue\n");
+  report("asInt32()", nsPerCall(iterations, [&](size_t) {
+    sink = intValue.asInt32();
+  }));
+  report("asInt64()", nsPerCall(iterations, [&](size_t) {
+    sink = intValue.asInt64();
+  }));
+  report("asDouble()", nsPerCall(iterations, [&](size_t) {
+    sink = (int64_t)doubleValue.asDouble();
+  }));
+  report("asBool()", nsPerCall(iterations, [&](size_t) {
+    sink = boolValue.asBool();
+  }));
+  report("construct from int32_t", nsPerCall(iterations, [&](size_t i) {
+    spConfigValue v((int32_t)i);
+    sink = (intptr_t)v.c_str();
+  }));
+  report("construct from double", nsPerCall(iterations, [&](size_t i) {
+    spConfigValue v((double)i / 7.0);
+    sink = (intptr_t)v.c_str();
+  }));
+  report("assign text", nsPerCall(iterations, [&](size_t i) {
+    spConfigValue v;
+    v = (i & 1) ? "some text" : "other text value";
+    sink = (intptr_t)v.c_str();
+  }));
+}
+
+/**
+ * @brief read() and save() of files from 1 KB to the maximum size, growing by 8
+ * 
+ */
+void benchFiles(spConfigMemoryStorage &storage, size_t maxSize)
+{
+  printf("\nfiles\n");
+  for (size_t size = 1024; size <= maxSize; size *= 8)
+  {
+    spConfigCorpus corpus;
+    size_t sections;
+    std::string content = corpus.generate(size, sections);
+    storage.setFile(BENCH_FILE, content.data(), content.length());
+    content.clear();
+    content.shrink_to_fit();
+
+    spConfig config;
+    config.setStorage(&storage);
+    config.setConfigFilePath(BENCH_PATH);
+    std::string name = "read() " + sizeName(size);
+    double ns = nsPerRun([&]() {
+      config.read();
+    });
+    std::string saved;
+    storage.getFile(BENCH_FILE, saved);
+    reportThroughput(name.c_str(), saved.length(), ns);
+
+    name = "save() " + sizeName(size);
+    spConfigKey key("section0", "key0");
+    int32_t i = 0;
+    ns = nsPerRun([&]() {
+      config.setValue(key, i++);
+      config.save();
+    });
+    storage.getFile(BENCH_FILE, saved);
+    reportThroughput(name.c_str(), saved.length(), ns);
+    storage.remove(BENCH_FILE);
+  }
+}
+
+/**
+ * @brief time from setValue() until the value is in the file saved by autosave
+ * 
+ */
+void benchAutosave(spConfigMemoryStorage &storage)
+{
+  spConfigCorpus corpus;
+  size_t sections;
+  std::string content = corpus.generate(4 * 1024, sections);
+  storage.setFile(BENCH_FILE, content.data(), content.length());
+  spConfig config;
+  config.setStorage(&storage);
+  config.setConfigFilePath(BENCH_PATH);
+  config.read();
+  config.setAutosave(true);
+
+  printf("\nautosave\n");
+  for (int i = 0; i < 3; i++)
+  {
+    std::string value = "autosaved-" + std::to_string(i);
+    auto start = std::chrono::steady_clock::now();
+    config.setValue("section0", "key0", value.c_str());
+    std::string saved;
+    while (!storage.getFile(BENCH_FILE, saved) || (saved.find(value) == std::string::npos))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("%-48s %12.1f ms\n", "setValue() until saved", ms);
+  }
+  config.setAutosave(false);
+}
+
+
+/**
+ * @brief our main function
+ * 
+ */
+int main(int argc, char *argv[])
+{
+  size_t maxSize = 16 * 1024 * 1024;
+  bool autosave = true;
+  for (int i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "--max-size") == 0) && (i + 1 < argc))
+    {
+      maxSize = strtoull(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--no-autosave") == 0)
+    {
+      autosave = false;
+    }
+    else if ((strcmp(argv[i], "--corpus") == 0) && (i + 2 < argc))
+    {
+      spConfigCorpus corpus;
+      size_t sections;
+      std::string content = corpus.generate(strtoull(argv[i + 2], nullptr, 10), sections);
+      FILE* f = fopen(argv[i + 1], "wb");
+      if ((f == nullptr) || (fwrite(content.data(), 1, content.length(), f) != content.length()))
+      {
+        printf("could not write %s\n", argv[i + 1]);
+        return 1;
+      }
+      fclose(f);
+      printf("%s: %u bytes in %u sections\n", argv[i + 1], (unsigned int)content.length(), (unsigned int)sections);
+      return 0;
+    }
+    else
+    {
+      printf("usage: %s [--max-size <bytes>] [--no-autosave] | --corpus <file> <bytes>\n", argv[0]);
+      return 1;
+    }
+  }
+
+  spConfigMemoryStorage storage;
+  benchAccess(storage);
+  benchValue();
+  benchFiles(storage, maxSize);
+  if (autosave)
+  {
+    benchAutosave(storage);
+  }
+  return 0;
+}
@@ -0,0 +1,410 @@
+/**
+ * contention benchmark for spConfig library
+ * 
+ * readers and writers access one spConfig object, while autosave and a saving thread write 
+ * its file, and report throughput, latency percentiles per operation, duration of saves and 
+ * the time readers and writers were stalled
+ * 
+ * usage:
+ *   spConfigContention [--readers <n>] [--writers <n>] [--seconds <s>] [--size <bytes>]
+ *                      [--write-pause-us <us>] [--save-ms <ms>] [--storage-latency-us <us>]
+ * 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <spConfig.h>
+#include "spConfigCorpus.h"
+
+
+#define BENCH_PATH  "/bench"
+#define BENCH_FILE  "/bench/config.ini"
+
+// operations taking at least this long count as stalled
+#define BENCH_STALL_NS  1000000
+
+
+/**
+ * @brief histogram of latencies with 16 buckets per power of 2, i.e. within about 6 %
+ * 
+ */
+class Histogram
+{
+  private:
+    static const size_t m_bucketCount = 64 * 16;
+    uint64_t m_buckets[m_bucketCount] = {};
+    uint64_t m_count = 0;
+    uint64_t m_totalNS = 0;
+    uint64_t m_maxNS = 0;
+
+    static size_t bucket(uint64_t ns)
+    {
+      if (ns < 16)
+      {
+        return ns;
+      }
+      size_t exp = 63 - __builtin_clzll(ns);
+      return (exp - 3) * 16 + ((ns >> (exp - 4)) & 15);
+    }
+
+    static uint64_t lowerBound(size_t idx)
+    {
+      if (idx < 16)
+      {
+        return idx;
+      }
+      size_t exp = idx / 16 + 3;
+      return (uint64_t)(16 + idx % 16) << (exp - 4);
+    }
+
+  public:
+    uint64_t stalls = 0;
+    uint64_t stalledNS = 0;
+
+    void record(uint64_t ns)
+    {
+      m_buckets[bucket(ns)]++;
+      m_count++;
+      m_totalNS += ns;
+      if (ns > m_maxNS)
+      {
+        m_maxNS = ns;
+      }
+      if (ns >= BENCH_STALL_NS)
+      {
+        stalls++;
+        stalledNS += ns;
+      }
+    }
+
+    void merge(const Histogram &other)
+    {
+      for (size_t i = 0; i < m_bucketCount; i++)
+      {
+        m_buckets[i] += other.m_buckets[i];
+      }
+      m_count += other.m_count;
+      m_totalNS += other.m_totalNS;
+      m_maxNS = (other.m_maxNS > m_maxNS) ? other.m_maxNS : m_maxNS;
+      stalls += other.stalls;
+      stalledNS += other.stalledNS;
+    }
+
+    uint64_t count() const
+    {
+      return m_count;
+    }
+
+    uint64_t maxNS() const
+    {
+      return m_maxNS;
+    }
+
+    double meanNS() const
+    {
+      return m_count ? (double)m_totalNS / m_count : 0;
+    }
+
+    uint64_t percentileNS(double p) const
+    {
+      uint64_t rank = (uint64_t)(p * m_count);
+      uint64_t seen = 0;
+      for (size_t i = 0; i < m_bucketCount; i++)
+      {
+        seen += m_buckets[i];
+        if (seen > rank)
+        {
+          return lowerBound(i);
+        }
+      }
+      return m_maxNS;
+    }
+
+};
+
+
+/**
+ * @brief memory storage timing each save from opening the temporary file until it replaced the file
+ * 
+ */
+class TimedStorage : public spConfigStorage
+{
+  private:
+    spConfigMemoryStorage m_storage;
+    std::chrono::steady_clock::time_point m_saveStart;
+
+  public:
+    std::mutex mutex; // guards saves
+    Histogram saves;
+
+    spConfigMemoryStorage& memory()
+    {
+      return m_storage;
+    }
+    bool openRead(const char* filename, spConfigFile &file) override
+    {
+      return m_storage.openRead(filename, file);
+    }
+    bool view(spConfigFile &file, spConfigSpan &content) override
+    {
+      return m_storage.view(file, content);
+    }
+    size_t read(spConfigFile &file, size_t pos, char* buf, size_t len) override
+    {
+      return m_storage.read(file, pos, buf, len);
+    }
+    bool openWrite(const char* filename, spConfigFile &file) override
+    {
+      m_saveStart = std::chrono::steady_clock::now();
+      return m_storage.openWrite(filename, file);
+    }
+    bool write(spConfigFile &file, spConfigSpan data) override
+    {
+      return m_storage.write(file, data);
+    }
+    bool sync(spConfigFile &file) override
+    {
+      return m_storage.sync(file);
+    }
+    bool close(spConfigFile &file) override
+    {
+      return m_storage.close(file);
+    }
+    bool rename(const char* from, const char* to) override
+    {
+      bool success = m_storage.rename(from, to);
+      uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_saveStart).count();
+      std::lock_guard<std::mutex> lock(mutex);
+      saves.record(ns);
+      return success;
+    }
+    bool remove(const char* filename) override
+    {
+      return m_storage.remove(filename);
+    }
+
+};
+
+
+struct Options
+{
+  int readers = 64;
+  int writers = 2;
+  double seconds = 5;
+  size_t size = 64 * 1024;
+  uint32_t writePauseUS = 100;
+  uint32_t saveMS = 100;
+  uint32_t storageLatencyUS = 0;
+};
+
+static std::atomic<bool> s_go{false};
+static std::atomic<bool> s_stop{false};
+static volatile int64_t sink;
+
+
+inline uint64_t nowNS()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void printRow(const char* name, const Histogram &h, double seconds, double unit, const char* unitName)
+{
+  printf("%-10s %12llu %12.0f %10.1f %10.1f %10.1f %10.1f %10.1f  %s\n", name, (unsigned long long)h.count(), h.count() / seconds, 
+         h.meanNS() / unit, h.percentileNS(0.5) / unit, h.percentileNS(0.99) / unit, h.percentileNS(0.999) / unit, h.maxNS() / unit, unitName);
+}
+
+bool parseOptions(int argc, char *argv[], Options &options)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc)
+    {
+      return false;
+    }
+    const char* arg = argv[i];
+    const char* value = argv[++i];
+    if (strcmp(arg, "--readers") == 0)
+    {
+      options.readers = atoi(value);
+    }
+    else if (strcmp(arg, "--writers") == 0)
+    {
+      options.writers = atoi(value);
+    }
+    else if (strcmp(arg, "--seconds") == 0)
+    {
+      options.seconds = atof(value);
+    }
+    else if (strcmp(arg, "--size") == 0)
+    {
+      options.size = strtoull(value, nullptr, 10);
+    }
+    else if (strcmp(arg, "--write-pause-us") == 0)
+    {
+      options.writePauseUS = atoi(value);
+    }
+    else if (strcmp(arg, "--save-ms") == 0)
+    {
+      options.saveMS = atoi(value);
+    }
+    else if (strcmp(arg, "--storage-latency-us") == 0)
+    {
+      options.storageLatencyUS = atoi(value);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/**
+ * @brief our main function
+ * 
+ */
+int main(int argc, char *argv[])
+{
+  Options options;
+  if (!parseOptions(argc, argv, options))
+  {
+    printf("usage: %s [--readers <n>] [--writers <n>] [--seconds <s>] [--size <bytes>]\n"
+           "          [--write-pause-us <us>] [--save-ms <ms>] [--storage-latency-us <us>]\n", argv[0]);
+    return 1;
+  }
+
+  TimedStorage storage;
+  spConfigCorpus corpus;
+  size_t sections;
+  std::string content = corpus.generate(options.size, sections);
+  storage.memory().setFile(BENCH_FILE, content.data(), content.length());
+  storage.memory().setLatency(0, options.storageLatencyUS);
+
+  spConfig config;
+  config.setStorage(&storage);
+  config.setConfigFilePath(BENCH_PATH);
+  config.read();
+  config.setAutosave(true);
+
+  // keys picked the same way on every machine
+  const size_t count = 4096;
+  std::vector<std::string> sectionNames, keyNames;
+  for (size_t i = 0; i < count; i++)
+  {
+    uint64_t r = corpus.next();
+    sectionNames.push_back(spConfigCorpus::section(r % sections));
+    keyNames.push_back(spConfigCorpus::key((r >> 32) % SPCONFIG_CORPUS_KEYS));
+  }
+  std::vector<spConfigKey> keys;
+  for (size_t i = 0; i < count; i++)
+  {
+    keys.push_back(spConfigKey(sectionNames[i].c_str(), keyNames[i].c_str()));
+  }
+
+  std::vector<Histogram> readHistograms(options.readers);
+  std::vector<Histogram> writeHistograms(options.writers);
+  Histogram saveCalls;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < options.readers; t++)
+  {
+    threads.emplace_back([&, t]() {
+      Histogram &h = readHistograms[t];
+      size_t i = t * 7919;
+      while (!s_go)
+      {
+        std::this_thread::yield();
+      }
+      while (!s_stop)
+      {
+        const spConfigKey &key = keys[i++ % count];
+        uint64_t start = nowNS();
+        sink = (i & 1) ? config.getInt32(key) : (int64_t)config.getString(key).length();
+        h.record(nowNS() - start);
+      }
+    });
+  }
+  for (int t = 0; t < options.writers; t++)
+  {
+    threads.emplace_back([&, t]() {
+      Histogram &h = writeHistograms[t];
+      size_t i = t * 104729;
+      while (!s_go)
+      {
+        std::this_thread::yield();
+      }
+      while (!s_stop)
+      {
+        const spConfigKey &key = keys[i++ % count];
+        uint64_t start = nowNS();
+        config.setValue(key, (int32_t)i);
+        h.record(nowNS() - start);
+        if (options.writePauseUS > 0)
+        {
+          std::this_thread::sleep_for(std::chrono::microseconds(options.writePauseUS));
+        }
+      }
+    });
+  }
+  if (options.saveMS > 0)
+  {
+    threads.emplace_back([&]() {
+      while (!s_go)
+      {
+        std::this_thread::yield();
+      }
+      while (!s_stop)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.saveMS));
+        uint64_t start = nowNS();
+        config.save();
+        saveCalls.record(nowNS() - start);
+      }
+    });
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  s_go = true;
+  std::this_thread::sleep_for(std::chrono::duration<double>(options.seconds));
+  s_stop = true;
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  config.setAutosave(false);
+
+  Histogram reads, writes;
+  for (auto &h : readHistograms)
+  {
+    reads.merge(h);
+  }
+  for (auto &h : writeHistograms)
+  {
+    writes.merge(h);
+  }
+
+  printf("readers %d, writers %d, %.1f s, file %u bytes, %u values, write pause %u us, save every %u ms, storage latency %u us\n\n",
+         options.readers, options.writers, seconds, (unsigned int)content.length(), (unsigned int)(sections * SPCONFIG_CORPUS_KEYS),
+         (unsigned int)options.writePauseUS, (unsigned int)options.saveMS, (unsigned int)options.storageLatencyUS);
+  printf("%-10s %12s %12s %10s %10s %10s %10s %10s\n", "operation", "count", "per s", "mean", "p50", "p99", "p999", "max");
+  printRow("get", reads, seconds, 1.0, "ns");
+  printRow("set", writes, seconds, 1.0, "ns");
+  printRow("save()", saveCalls, seconds, 1000000.0, "ms");
+  {
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    printRow("file save", storage.saves, seconds, 1000000.0, "ms");
+  }
+  printf("\nstalled >= %u us: get %llu times for %.1f ms, set %llu times for %.1f ms\n", BENCH_STALL_NS / 1000,
+         (unsigned long long)reads.stalls, reads.stalledNS / 1000000.0, (unsigned long long)writes.stalls, writes.stalledNS / 1000000.0);
+  return 0;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file spConfigCorpus.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief generator of synthetic configuration files for benchmarks
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version
+ * 
+ */
+
+
+#ifndef SPCONFIGCORPUS_H
+#define SPCONFIGCORPUS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+
+// keys in every section of a generated file, named key0 ... key15
+#define SPCONFIG_CORPUS_KEYS  16
+
+
+class spConfigCorpus
+{
+  private:
+    uint64_t m_state;
+
+  public:
+    spConfigCorpus(uint64_t seed = 1) : m_state(seed ? seed : 1) {}
+
+    /**
+     * @brief return the next pseudo random number, xorshift64*, the same sequence on every machine for a seed
+     * 
+     * @return uint64_t 
+     */
+    uint64_t next()
+    {
+      m_state ^= m_state >> 12;
+      m_state ^= m_state << 25;
+      m_state ^= m_state >> 27;
+      return m_state * 0x2545F4914F6CDD1DULL;
+    }
+
+    /**
+     * @brief return the name of a section of generated files
+     * 
+     * @param i  number of section
+     * @return std::string 
+     */
+    static std::string section(size_t i)
+    {
+      return "section" + std::to_string(i);
+    }
+
+    /**
+     * @brief return the name of a key in each section of generated files
+     * 
+     * @param j  number of key, less than SPCONFIG_CORPUS_KEYS
+     * @return std::string 
+     */
+    static std::string key(size_t j)
+    {
+      return "key" + std::to_string(j);
+    }
+
+    /**
+     * @brief return a configuration file of about the size given, with sections of SPCONFIG_CORPUS_KEYS keys 
+     *        holding integer, double, bool and text values, together with comments, empty lines and 
+     *        spaces around '=', the same content for the same seed and size
+     * 
+     * @param bytes  size of content, completed to the end of the section
+     * @param sections  number of sections generated
+     * @return std::string  content
+     */
+    std::string generate(size_t bytes, size_t &sections)
+    {
+      static const char* words[] = {"alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel"};
+      std::string content;
+      content.reserve(bytes + 1024);
+      char line[100];
+      sections = 0;
+      while (content.length() < bytes)
+      {
+        if (next() % 4 == 0)
+        {
+          content.append("; generated section\n");
+        }
+        content.append("[" + section(sections++) + "]\n");
+        for (size_t j = 0; j < SPCONFIG_CORPUS_KEYS; j++)
+        {
+          uint64_t r = next();
+          const char* eq = (r & 0x100) ? " = " : "=";
+          switch (r % 5)
+          {
+            case 0:
+              snprintf(line, sizeof(line), "key%u%s%d\n", (unsigned int)j, eq, (int)(int32_t)(r >> 32));
+              break;
+            case 1:
+              snprintf(line, sizeof(line), "key%u%s%.3f\n", (unsigned int)j, eq, (double)(r >> 40) / 1000.0);
+              break;
+            case 2:
+              snprintf(line, sizeof(line), "key%u%s%s\n", (unsigned int)j, eq, (r & 0x200) ? "true" : "false");
+              break;
+            case 3:
+              snprintf(line, sizeof(line), "key%u%s%s %s # comment\n", (unsigned int)j, eq, words[(r >> 12) % 8], words[(r >> 16) % 8]);
+              break;
+            default:
+              snprintf(line, sizeof(line), "key%u%s%s-%u\n", (unsigned int)j, eq, words[(r >> 12) % 8], (unsigned int)(r >> 48));
+              break;
+          }
+          content.append(line);
+        }
+        content.append("\n");
+      }
+      return content;
+    }
+
+};
+
+#endif // SPCONFIGCORPUS_H
@@ -0,0 +1,188 @@
+/**
+ * parse throughput of spConfig library on the files of the fuzz corpus
+ * 
+ * each file is read viewed in place from an spConfigMemoryStorage and in chunks of SPCONFIG_FILEBUFSIZE 
+ * through readFile(), the same two ways the fuzz target reads them, so changes to the parser can 
+ * be checked for both robustness and speed on the same inputs
+ * 
+ * usage:
+ *   spConfigParseCorpus [<corpus folder>]   the folder defaults to fuzz/corpus of the source tree
+ * 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+#include <spConfig.h>
+#include "spConfigCorpus.h"
+
+
+// files read by the benchmarks
+#define BENCH_PATH  "/bench"
+#define BENCH_FILE  "/bench/config.ini"
+
+// minimum time to repeat a throughput benchmark for
+#define BENCH_MIN_NS  200000000.0
+
+#ifndef SPCONFIG_FUZZ_CORPUS
+  #define SPCONFIG_FUZZ_CORPUS  "fuzz/corpus"
+#endif
+
+
+// config object reading files from a string in chunks, as readFile() does without storage
+class ChunkedConfig : public spConfig
+{
+  public:
+    std::string content;
+
+  protected:
+    size_t readFile(std::string filename, char* buf, size_t startPos, size_t maxBytes) override
+    {
+      if ((filename != BENCH_FILE) || (startPos >= content.length()))
+      {
+        return 0;
+      }
+      size_t len = content.length() - startPos;
+      len = (len < maxBytes) ? len : maxBytes;
+      memcpy(buf, content.data() + startPos, len);
+      return len;
+    }
+};
+
+struct CorpusFile
+{
+  std::string name;
+  std::string content;
+};
+
+
+/**
+ * @brief return the average time of calls to a function, repeated until BENCH_MIN_NS passed
+ * 
+ * @param f  function
+ * @return double  ns per call
+ */
+template <class F> double nsPerRun(F f)
+{
+  size_t runs = 0;
+  auto start = std::chrono::steady_clock::now();
+  double ns = 0;
+  do
+  {
+    f();
+    runs++;
+    ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  } while (ns < BENCH_MIN_NS);
+  return ns / runs;
+}
+
+void reportThroughput(const char* name, size_t bytes, double ns)
+{
+  printf("%-48s %12.1f MB/s  (%.3f ms)\n", name, bytes / ns * 1000.0, ns / 1000000.0);
+}
+
+
+/**
+ * @brief read() of files viewed in place and in chunks, each file and all files in turn
+ * 
+ */
+void benchParse(std::vector<CorpusFile> &files)
+{
+  spConfigMemoryStorage storage;
+  size_t totalBytes = 0;
+  double totalViewedNS = 0;
+  double totalChunkedNS = 0;
+  for (CorpusFile &file : files)
+  {
+    storage.setFile(BENCH_FILE, file.content.data(), file.content.length());
+    spConfig viewed;
+    viewed.setStorage(&storage);
+    viewed.setConfigFilePath(BENCH_PATH);
+    double viewedNS = nsPerRun([&]() {
+      viewed.read();
+    });
+    storage.remove(BENCH_FILE);
+
+    ChunkedConfig chunked;
+    chunked.setStorage(nullptr);
+    chunked.content = file.content;
+    chunked.setConfigFilePath(BENCH_PATH);
+    double chunkedNS = nsPerRun([&]() {
+      chunked.read();
+    });
+
+    printf("\n%s, %u bytes\n", file.name.c_str(), (unsigned int)file.content.length());
+    reportThroughput("read() viewed", file.content.length(), viewedNS);
+    reportThroughput("read() in chunks", file.content.length(), chunkedNS);
+    totalBytes += file.content.length();
+    totalViewedNS += viewedNS;
+    totalChunkedNS += chunkedNS;
+  }
+
+  printf("\nall %u files, %u bytes\n", (unsigned int)files.size(), (unsigned int)totalBytes);
+  reportThroughput("read() viewed", totalBytes, totalViewedNS);
+  reportThroughput("read() in chunks", totalBytes, totalChunkedNS);
+}
+
+
+/**
+ * @brief our main function
+ * 
+ */
+int main(int argc, char *argv[])
+{
+  const char* folder = SPCONFIG_FUZZ_CORPUS;
+  if (argc > 2)
+  {
+    printf("usage: %s [<corpus folder>]\n", argv[0]);
+    return 1;
+  }
+  if (argc == 2)
+  {
+    folder = argv[1];
+  }
+
+  std::vector<CorpusFile> files;
+  std::error_code ec;
+  for (auto &entry : std::filesystem::directory_iterator(folder, ec))
+  {
+    FILE* f = fopen(entry.path().string().c_str(), "rb");
+    if (f == nullptr)
+    {
+      continue;
+    }
+    CorpusFile file;
+    file.name = entry.path().filename().string();
+    char buf[4096];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), f)) > 0)
+    {
+      file.content.append(buf, len);
+    }
+    fclose(f);
+    files.push_back(file);
+  }
+  if (ec || files.empty())
+  {
+    printf("no files in %s\n", folder);
+    return 1;
+  }
+  std::sort(files.begin(), files.end(), [](const CorpusFile &a, const CorpusFile &b) {
+    return a.name < b.name;
+  });
+
+  // a generated file of regular entries to compare the corpus with
+  spConfigCorpus corpus;
+  size_t sections;
+  files.push_back({"generated", corpus.generate(64 * 1024, sections)});
+
+  printf("parse throughput of %s\n", folder);
+  benchParse(files);
+  return 0;
+}
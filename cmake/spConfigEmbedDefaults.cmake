@@ -0,0 +1,150 @@
+# -------------------------------------------------------
+# spConfigEmbedDefaults.cmake
+#
+# embeds a default configuration file into the binary as a table for
+# spConfigBase::setDefaults(), so no default file needs to be read at runtime
+#
+# usage in a project's CMakeLists.txt:
+#   spconfig_embed_defaults(<target> <ini file> <table name>)
+#   e.g. spconfig_embed_defaults(myApp config-default.ini appDefaults)
+# and in code:
+#   #include <appDefaults.h>
+#   config.setDefaults(appDefaults);
+#
+# lines longer than SPCONFIG_MAXLINELENGTH are skipped like spConfigBase::read() does, with a warning,
+# a project building spConfig with another SPCONFIG_MAXLINELENGTH sets the CMake variable of that name as well
+#
+# when run as a script with cmake -P, it converts the file
+#   cmake -DINI_FILE=<ini file> -DOUTPUT_FILE=<header> -DTABLE_NAME=<table name> [-DMAX_LINE_LENGTH=<length>] -P spConfigEmbedDefaults.cmake
+# -------------------------------------------------------
+
+
+if(NOT CMAKE_SCRIPT_MODE_FILE)
+
+    set(SPCONFIG_EMBED_SCRIPT ${CMAKE_CURRENT_LIST_FILE} CACHE INTERNAL "script to embed default configuration files")
+
+    function(spconfig_embed_defaults target ini_file table_name)
+        get_filename_component(ini_path ${ini_file} ABSOLUTE)
+        set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/spConfigEmbedded)
+        set(out_file ${out_dir}/${table_name}.h)
+        # same default as in spConfigBase.h
+        set(max_line_length 100)
+        if(SPCONFIG_MAXLINELENGTH)
+            set(max_line_length ${SPCONFIG_MAXLINELENGTH})
+        endif()
+        add_custom_command(
+            OUTPUT ${out_file}
+            COMMAND ${CMAKE_COMMAND} -DINI_FILE=${ini_path} -DOUTPUT_FILE=${out_file} -DTABLE_NAME=${table_name} -DMAX_LINE_LENGTH=${max_line_length} -P ${SPCONFIG_EMBED_SCRIPT}
+            DEPENDS ${ini_path} ${SPCONFIG_EMBED_SCRIPT}
+            COMMENT "embedding ${ini_file} as ${table_name}"
+            VERBATIM)
+        target_sources(${target} PRIVATE ${out_file})
+        target_include_directories(${target} PRIVATE ${out_dir})
+    endfunction()
+
+    return()
+endif()
+
+
+# -------------------------------------------------------
+# script mode, parse like spConfigBase::parseIniFile()
+# -------------------------------------------------------
+if(NOT INI_FILE OR NOT OUTPUT_FILE OR NOT TABLE_NAME)
+    message(FATAL_ERROR "spConfigEmbedDefaults.cmake requires INI_FILE, OUTPUT_FILE and TABLE_NAME")
+endif()
+if(NOT MAX_LINE_LENGTH)
+    set(MAX_LINE_LENGTH 100)
+endif()
+
+file(READ ${INI_FILE} content)
+string(APPEND content "\n")
+# file(READ) drops the '\r' of a "\r\n" line end, which read() counts in the line length, it is looked up in the raw bytes
+file(READ ${INI_FILE} raw_hex HEX)
+set(raw_pos 0)
+
+set(entries "")
+set(section "")
+string(LENGTH "${content}" content_len)
+set(pos 0)
+while(pos LESS content_len)
+    string(SUBSTRING "${content}" ${pos} -1 rest)
+    string(FIND "${rest}" "\n" line_len)
+    string(SUBSTRING "${rest}" 0 ${line_len} line)
+    math(EXPR pos "${pos} + ${line_len} + 1")
+    math(EXPR hex_pos "(${raw_pos} + ${line_len}) * 2")
+    string(SUBSTRING "${raw_hex}" ${hex_pos} 2 line_end)
+    if(line_end STREQUAL "0d")
+        math(EXPR line_len "${line_len} + 1")
+    endif()
+    math(EXPR raw_pos "${raw_pos} + ${line_len} + 1")
+
+    # lines exceeding the maximum length are skipped as a whole, the length includes comments and a '\r'
+    if(line_len GREATER MAX_LINE_LENGTH)
+        string(SUBSTRING "${line}" 0 40 line_start)
+        message(WARNING "${INI_FILE}: line starting with '${line_start}...' exceeds maximum length of ${MAX_LINE_LENGTH} and is skipped")
+        continue()
+    endif()
+
+    # everything from '#' or ';' is a comment
+    string(REGEX REPLACE "\\\\?[#;].*" "" line "${line}")
+    string(STRIP "${line}" line)
+    string(LENGTH "${line}" len)
+    if(len EQUAL 0)
+        continue()
+    endif()
+
+    string(SUBSTRING "${line}" 0 1 first)
+    if(first STREQUAL "[")
+        # section, empty or not ] closed skips the section's values
+        set(section "")
+        math(EXPR last "${len} - 1")
+        string(SUBSTRING "${line}" ${last} 1 last_char)
+        if(len GREATER 2 AND last_char STREQUAL "]")
+            math(EXPR inner_len "${len} - 2")
+            string(SUBSTRING "${line}" 1 ${inner_len} section)
+            string(STRIP "${section}" section)
+        endif()
+    elseif(NOT section STREQUAL "")
+        # key = value
+        string(FIND "${line}" "=" equal_pos)
+        set(value "")
+        if(equal_pos EQUAL -1)
+            set(key "${line}")
+        else()
+            string(SUBSTRING "${line}" 0 ${equal_pos} key)
+            math(EXPR value_pos "${equal_pos} + 1")
+            string(SUBSTRING "${line}" ${value_pos} -1 value)
+        endif()
+        string(STRIP "${key}" key)
+        string(STRIP "${value}" value)
+        if(NOT key STREQUAL "")
+            foreach(var section key value)
+                string(REPLACE "\\" "\\\\" ${var}_c "${${var}}")
+                string(REPLACE "\"" "\\\"" ${var}_c "${${var}_c}")
+            endforeach()
+            string(APPEND entries "  { spConfigKey(\"${section_c}\", \"${key_c}\"), \"${value_c}\" },\n")
+        endif()
+    endif()
+endwhile()
+
+if(entries STREQUAL "")
+    # no empty arrays, entries without value are skipped by setDefaults()
+    set(entries "  { spConfigKey(\"\", \"\"), nullptr },\n")
+endif()
+
+string(TOUPPER "${TABLE_NAME}" guard)
+get_filename_component(ini_name ${INI_FILE} NAME)
+file(WRITE ${OUTPUT_FILE}
+"// generated by spConfigEmbedDefaults.cmake from ${ini_name}, do not edit\n"
+"\n"
+"#ifndef ${guard}_H\n"
+"#define ${guard}_H\n"
+"\n"
+"#include <spConfigDefaults.h>\n"
+"\n"
+"constexpr spConfigDefaultEntry ${TABLE_NAME}[] =\n"
+"{\n"
+"${entries}"
+"};\n"
+"\n"
+"#endif // ${guard}_H\n")
@@ -0,0 +1,85 @@
+/**
+ * example code for spConfig library
+ *
+ * reads and saves configuration files kept in memory, with failures and partial writes injected
+ * into the storage, so no file on disk is touched, see tests/spConfigStorageTest.cpp for the checks
+ *
+ */
+
+
+#include <filesystem>
+#include <spConfig.h>
+
+// storage before config, as it must outlive the config object
+spConfigMemoryStorage storage;
+spConfig config;
+
+
+/**
+ * @brief print the content of a file in the storage
+ *
+ * @param filename  name of file in storage
+ */
+void printFile(const char* filename)
+{
+  std::string content;
+  if (storage.getFile(filename, content))
+  {
+    printf("   content of %s:\n%s", filename, content.c_str());
+  }
+}
+
+
+/**
+ * @brief our main function
+ *
+ */
+int main(int argc, char *argv[])
+{
+  std::string a = argv[0];
+  printf("running %s\n", a.substr(a.rfind(std::filesystem::path::preferred_separator) + 1).c_str());
+  // ========================================================
+
+  const char* configFile = "/mem/config.ini";
+  const char* defaultFile = "/mem/config-default.ini";
+  const char* defaults = "[net]\nhost = localhost\nport = 8080\n";
+  const char* values = "; values\n[net]\nport = 9090 # not the default\n[ui]\ntheme=dark\n";
+  storage.setFile(defaultFile, defaults, strlen(defaults));
+  storage.setFile(configFile, values, strlen(values));
+
+  config.setStorage(&storage);
+  config.setConfigFilePath("/mem");
+
+  printf("configuration values read:\n");
+  config.read();
+  printf("   host: %s\n", config.getString("net", "host").c_str());
+  printf("   port: %i\n", config.getInt32("net", "port"));
+  printf("   theme: %s\n", config.getString("ui", "theme").c_str());
+
+  printf("save changed value:\n");
+  config.setValue("ui", "theme", "light");
+  config.save();
+  printFile(configFile);
+
+  printf("save with failing rename:\n");
+  storage.setFaults(SPCONFIG_FAULT_RENAME);
+  config.setValue("ui", "theme", "blue");
+  config.save();
+  printf("   still changed: %s\n", config.changed() ? "yes" : "no");
+  printFile(configFile);
+
+  printf("save cut short as by a power loss:\n");
+  storage.setFaults(0);
+  storage.setWriteLimit(10);
+  config.save();
+  printFile(configFile);
+
+  printf("save without faults:\n");
+  storage.setWriteLimit(SIZE_MAX);
+  config.save();
+  printFile(configFile);
+
+  // ========================================================
+  printf("done\n");
+  return 0;
+}
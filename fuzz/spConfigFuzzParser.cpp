@@ -0,0 +1,279 @@
+/**
+ * fuzz target for the ini parser of spConfig library
+ * 
+ * each input is read as 'config.ini' twice, once viewed in place from an spConfigMemoryStorage 
+ * and once in chunks of SPCONFIG_FILEBUFSIZE through readFile(), both must result in the same 
+ * values, which must also be read back unchanged after saving them
+ * 
+ * with clang, it is built for libFuzzer, e.g.
+ *   spConfigFuzzParser -dict=ini.dict corpus
+ * otherwise, it is built with a driver running files and directories given and, with -runs=<n>, 
+ * inputs mutated from them
+ *   spConfigFuzzParser [-runs=<n>] [-seed=<n>] corpus
+ * 
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <spConfigBase.h>
+
+
+// files read and written by the fuzz target
+#define FUZZ_PATH  "/fuzz"
+#define FUZZ_FILE  "/fuzz/config.ini"
+
+typedef std::map<std::pair<std::string, std::string>, std::string> ValueMap;
+
+
+// config object reading files from a string in chunks, as readFile() does without storage
+class ChunkedConfig : public spConfigBase
+{
+  public:
+    std::string content;
+
+  protected:
+    size_t readFile(std::string filename, char* buf, size_t startPos, size_t maxBytes) override
+    {
+      if ((filename != FUZZ_FILE) || (startPos >= content.length()))
+      {
+        return 0;
+      }
+      size_t len = content.length() - startPos;
+      len = (len < maxBytes) ? len : maxBytes;
+      memcpy(buf, content.data() + startPos, len);
+      return len;
+    }
+    size_t saveFile(std::string /*filename*/, char* /*buf*/, size_t /*startPos*/, size_t writeBytes) override
+    {
+      return writeBytes;
+    }
+};
+
+
+/**
+ * @brief collect all values of a config object
+ * 
+ * @param config 
+ * @param values  map to hold values by section and key
+ */
+static void collect(spConfigBase &config, ValueMap &values)
+{
+  std::vector<std::string> sections;
+  config.forEachSection([&sections](const char* section) {
+    sections.push_back(section);
+    return true;
+  });
+  for (const std::string &section : sections)
+  {
+    config.forEachInSection(section.c_str(), [&values, &section](const char* key, const spConfigValue &value) {
+      values[std::make_pair(section, std::string(key))] = value.c_str() ? value.c_str() : "";
+      return true;
+    });
+  }
+}
+
+/**
+ * @brief report differing values and abort, so the fuzzer keeps the input
+ * 
+ */
+static void check(bool ok, const char* what, const ValueMap &expected, const ValueMap &found)
+{
+  if (ok)
+  {
+    return;
+  }
+  fprintf(stderr, "%s: %u values expected, %u found\n", what, (unsigned int)expected.size(), (unsigned int)found.size());
+  for (auto &entry : expected)
+  {
+    auto it = found.find(entry.first);
+    if ((it == found.end()) || (it->second != entry.second))
+    {
+      fprintf(stderr, "  [%s] %s='%s' but found '%s'\n", entry.first.first.c_str(), entry.first.second.c_str(), entry.second.c_str(), 
+              (it == found.end()) ? "(none)" : it->second.c_str());
+    }
+  }
+  abort();
+}
+
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  static spConfigMemoryStorage storage;
+  storage.setFile(FUZZ_FILE, (const char*)data, size);
+
+  // whole content viewed in place
+  spConfigBase viewed;
+  viewed.setStorage(&storage);
+  viewed.setConfigFilePath(FUZZ_PATH);
+  viewed.read();
+  ValueMap viewedValues;
+  collect(viewed, viewedValues);
+
+  // content in chunks
+  ChunkedConfig chunked;
+  chunked.setStorage(nullptr);
+  chunked.content.assign((const char*)data, size);
+  chunked.setConfigFilePath(FUZZ_PATH);
+  chunked.read();
+  ValueMap chunkedValues;
+  collect(chunked, chunkedValues);
+  check(viewedValues == chunkedValues, "chunked read differs", viewedValues, chunkedValues);
+
+  // saved values read back, unless names were cut by zero bytes
+  if (memchr(data, 0, size) == nullptr)
+  {
+    viewed.setValue("fuzz", "saved", "1");
+    viewed.save();
+    viewed.read();
+    ValueMap savedValues;
+    collect(viewed, savedValues);
+    viewedValues[std::make_pair(std::string("fuzz"), std::string("saved"))] = "1";
+    // lines of 'key=value' or '[section]' not fitting SPCONFIG_MAXLINELENGTH are not saved
+    for (auto it = viewedValues.begin(); it != viewedValues.end(); )
+    {
+      bool fits = (it->first.first.length() + 2 <= SPCONFIG_MAXLINELENGTH) && 
+                  (it->first.second.length() + 1 + it->second.length() <= SPCONFIG_MAXLINELENGTH);
+      it = fits ? std::next(it) : viewedValues.erase(it);
+    }
+    check(viewedValues == savedValues, "saved values differ", viewedValues, savedValues);
+  }
+  storage.remove(FUZZ_FILE);
+  return 0;
+}
+
+
+#ifdef SPCONFIG_FUZZ_STANDALONE
+
+#include <filesystem>
+
+/**
+ * @brief change an input by flipping, inserting, removing or copying bytes, mostly ini syntax
+ * 
+ * @param input 
+ * @param state  state of xorshift random numbers
+ */
+static void mutate(std::string &input, uint64_t &state)
+{
+  auto next = [&state]() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  };
+  static const char* tokens[] = { "[", "]", "=", "#", ";", "\\", "\n", "\r\n", " ", "\t", "[s]\n", "k=v\n", "\xff", "\0" };
+  size_t changes = 1 + next() % 8;
+  for (size_t i = 0; i < changes; i++)
+  {
+    size_t pos = input.empty() ? 0 : next() % (input.length() + 1);
+    switch (next() % 5)
+    {
+      case 0:
+        if (pos < input.length())
+        {
+          input[pos] = (char)next();
+        }
+        break;
+      case 1:
+      {
+        const char* token = tokens[next() % (sizeof(tokens) / sizeof(tokens[0]))];
+        input.insert(pos, token, token[0] ? strlen(token) : 1);
+        break;
+      }
+      case 2:
+        input.erase(pos, next() % 16);
+        break;
+      case 3:
+        input.insert(pos, next() % 300, (char)(" x=\n"[next() % 4]));
+        break;
+      default:
+        if (!input.empty())
+        {
+          size_t from = next() % input.length();
+          input.insert(pos, input.substr(from, next() % 200));
+        }
+        break;
+    }
+  }
+}
+
+/**
+ * @brief run files and the files of directories given and, with -runs=<n>, n inputs mutated from them
+ * 
+ */
+int main(int argc, char *argv[])
+{
+  size_t runs = 0;
+  uint64_t seed = 1;
+  std::vector<std::string> inputs;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strncmp(argv[i], "-runs=", 6) == 0)
+    {
+      runs = strtoull(argv[i] + 6, nullptr, 10);
+    }
+    else if (strncmp(argv[i], "-seed=", 6) == 0)
+    {
+      seed = strtoull(argv[i] + 6, nullptr, 10);
+    }
+    else if (argv[i][0] == '-')
+    {
+      // other libFuzzer options are ignored
+    }
+    else
+    {
+      std::vector<std::filesystem::path> files;
+      if (std::filesystem::is_directory(argv[i]))
+      {
+        for (auto &entry : std::filesystem::directory_iterator(argv[i]))
+        {
+          files.push_back(entry.path());
+        }
+      }
+      else
+      {
+        files.push_back(argv[i]);
+      }
+      for (auto &file : files)
+      {
+        FILE* f = fopen(file.string().c_str(), "rb");
+        if (!f)
+        {
+          fprintf(stderr, "could not read %s\n", file.string().c_str());
+          return 1;
+        }
+        std::string input;
+        char buf[4096];
+        size_t len;
+        while ((len = fread(buf, 1, sizeof(buf), f)) > 0)
+        {
+          input.append(buf, len);
+        }
+        fclose(f);
+        LLVMFuzzerTestOneInput((const uint8_t*)input.data(), input.length());
+        inputs.push_back(input);
+      }
+    }
+  }
+  if (inputs.empty())
+  {
+    inputs.push_back("");
+  }
+
+  uint64_t state = seed ? seed : 1;
+  for (size_t run = 0; run < runs; run++)
+  {
+    std::string input = inputs[run % inputs.size()];
+    mutate(input, state);
+    LLVMFuzzerTestOneInput((const uint8_t*)input.data(), input.length());
+  }
+  printf("%u inputs and %u mutations run\n", (unsigned int)inputs.size(), (unsigned int)runs);
+  return 0;
+}
+
+#endif // SPCONFIG_FUZZ_STANDALONE
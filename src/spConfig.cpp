@@ -2,13 +2,22 @@
  * @file spConfig.cpp
  * @author krokoreit (krokoreit@gmail.com)
  * @brief class to handle configuration values and files
- * @version 2.1.3
- * @date 2024-10-23
+ * @version 2.2.0
+ * @date 2026-10-18
  * @copyright Copyright (c) 2024
  * 
  */
 
 #include <spConfig.h>
+#include <filesystem>
+
+// watching files with inotify on Linux, otherwise by polling the file times
+#if defined(__linux__) && !defined(SPCONFIG_NO_INOTIFY)
+  #define SPCONFIG_USE_INOTIFY 1
+  #include <sys/inotify.h>
+  #include <poll.h>
+  #include <unistd.h>
+#endif
 
 
 /*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
@@ -28,6 +37,24 @@ spConfig::~spConfig(){
   if (m_pLoopThread != nullptr)
   {
     setAutosave(false);
+    m_pLoopThread->join();
+    delete m_pLoopThread;
+    m_pLoopThread = nullptr;
+  }
+  if (m_pNotifyThread != nullptr)
+  {
+    setNotifyAsync(false);
+    onChangeQueued(); // wake up task to end
+    m_pNotifyThread->join();
+    delete m_pNotifyThread;
+    m_pNotifyThread = nullptr;
+  }
+  if (m_pWatchThread != nullptr)
+  {
+    setWatch(false);
+    m_pWatchThread->join();
+    delete m_pWatchThread;
+    m_pWatchThread = nullptr;
   }
 }
 
@@ -103,7 +130,8 @@ size_t spConfig::readFile(std::string filename, char* buf, size_t startPos, size
  */
 size_t spConfig::saveFile(std::string filename, char* buf, size_t startPos, size_t writeBytes)
 {
-  FILE *pFile = fopen(filename.c_str(), "w");
+  // new file for first chunk, following chunks are added to it
+  FILE *pFile = fopen(filename.c_str(), (startPos > 0) ? "r+" : "w");
   if (!pFile)
   {
     spLOGF_E("spConfig::saveFile() failed to get handle for %s", filename.c_str());
@@ -133,11 +161,81 @@ size_t spConfig::saveFile(std::string filename, char* buf, size_t startPos, size
  * 
  */
 void spConfig::ensureLoopTask() {
-  if (m_pLoopThread == nullptr)
+  std::thread *pEndedThread = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_loopMutex);
+    if (m_loopTaskRunning)
+    {
+      return;
+    }
+    // previous task has ended, it is taken over and joined after unlocking, so no other caller sees it
+    pEndedThread = m_pLoopThread;
+    m_loopTaskRunning = true;
+    m_pLoopThread = new std::thread(config_loop_task, this);
+  }
+  if (pEndedThread != nullptr)
+  {
+    pEndedThread->join();
+    delete pEndedThread;
+  }
+}
+
+/**
+ * @brief create notification task if not running
+ * 
+ */
+void spConfig::ensureNotifyTask() {
+  std::thread *pEndedThread = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_notifyMutex);
+    if (m_notifyTaskRunning)
+    {
+      return;
+    }
+    // previous task has ended, it is taken over and joined after unlocking, so no other caller sees it
+    pEndedThread = m_pNotifyThread;
+    m_notifyTaskRunning = true;
+    m_pNotifyThread = new std::thread(config_notify_task, this);
+  }
+  if (pEndedThread != nullptr)
+  {
+    pEndedThread->join();
+    delete pEndedThread;
+  }
+}
+
+/**
+ * @brief function called when a change was queued for the notification task
+ * 
+ */
+void spConfig::onChangeQueued()
+{
+  std::lock_guard<std::mutex> lock(m_notifyMutex);
+  m_changeQueued = true;
+  m_notifyCondition.notify_one();
+}
+
+/**
+ * @brief create watch task if not running
+ * 
+ */
+void spConfig::ensureWatchTask() {
+  std::thread *pEndedThread = nullptr;
   {
-    std::thread t(config_loop_task, this);
-    m_pLoopThread = &t;
-    m_pLoopThread->detach();
+    std::lock_guard<std::mutex> lock(m_watchMutex);
+    if (m_watchTaskRunning)
+    {
+      return;
+    }
+    // previous task has ended, it is taken over and joined after unlocking, so no other caller sees it
+    pEndedThread = m_pWatchThread;
+    m_watchTaskRunning = true;
+    m_pWatchThread = new std::thread(config_watch_task, this);
+  }
+  if (pEndedThread != nullptr)
+  {
+    pEndedThread->join();
+    delete pEndedThread;
   }
 }
 
@@ -158,18 +256,169 @@ uint64_t spConfig::timeSinceEpochMillisec() {
  * @param pConfig   pointer to object given to xTaskCreate()
  */
 void spConfig::config_loop_task(spConfig* pConfig) {
-  while (pConfig->getAutosave())
+  while (true)
   {
-    if (pConfig->changed())
     {
-      uint64_t timeMS = pConfig->getNextAutosaveTimeMS();
-      if ((timeMS > 0) && (pConfig->timeSinceEpochMillisec() > timeMS))
+      // end decided under lock, so ensureLoopTask() knows whether a new task is needed
+      std::lock_guard<std::mutex> lock(pConfig->m_loopMutex);
+      if (!pConfig->getAutosave())
       {
-        pConfig->save();
+        pConfig->m_loopTaskRunning = false;
+        break;
       }
     }
+    pConfig->autosaveIfDue(pConfig->timeSinceEpochMillisec());
     // sleep for 1 sec
     std::this_thread::sleep_for(std::chrono::seconds(1));
   }
-  pConfig->m_pLoopThread = nullptr;
+}
+
+/**
+ * @brief task running while notifications are asynchronous, calls subscribers for queued changes
+ * 
+ * @param pConfig   pointer to config object
+ */
+void spConfig::config_notify_task(spConfig* pConfig) {
+  std::unique_lock<std::mutex> lock(pConfig->m_notifyMutex);
+  while (true)
+  {
+    // end decided under lock, so ensureNotifyTask() knows whether a new task is needed
+    if (!pConfig->getNotifyAsync())
+    {
+      pConfig->m_notifyTaskRunning = false;
+      break;
+    }
+    // wait for change or check every sec for being stopped
+    pConfig->m_notifyCondition.wait_for(lock, std::chrono::seconds(1), [pConfig] { return pConfig->m_changeQueued; });
+    pConfig->m_changeQueued = false;
+    lock.unlock();
+    pConfig->dispatchChanges();
+    lock.lock();
+  }
+}
+
+/**
+ * @brief task running while in watch mode, calls reload() once the files read by reload() have not 
+ *        changed for SPCONFIG_WATCH_DEBOUNCE_MS and differ from what the last save() wrote to them
+ * 
+ * @param pConfig   pointer to config object
+ */
+void spConfig::config_watch_task(spConfig* pConfig) {
+  std::vector<std::string> filenames = pConfig->getWatchFilenames();
+  // stamps of files at the last reload or save and as last seen while polling
+  std::map<std::string, spConfigFileStamp> stamps;
+  for (const std::string &filename : filenames)
+  {
+    stamps[filename] = fileStamp(filename);
+  }
+  std::map<std::string, spConfigFileStamp> seenStamps = stamps;
+  // time of last change seen or 0 for none
+  uint64_t changeTimeMS = 0;
+
+#ifdef SPCONFIG_USE_INOTIFY
+  // watch folders, as editors often replace files instead of writing to them
+  int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd >= 0)
+  {
+    uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE;
+    for (const std::string &filename : filenames)
+    {
+      std::string folder = std::filesystem::path(filename).parent_path().string();
+      if (inotify_add_watch(fd, folder.empty() ? "." : folder.c_str(), mask) < 0)
+      {
+        spLOGF_E("spConfig::config_watch_task() failed to watch %s, polling instead", filename.c_str());
+        ::close(fd);
+        fd = -1;
+        break;
+      }
+    }
+  }
+  char eventBuf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+#endif
+
+  while (true)
+  {
+    {
+      // end decided under lock, so ensureWatchTask() knows whether a new task is needed
+      std::lock_guard<std::mutex> lock(pConfig->m_watchMutex);
+      if (!pConfig->getWatch())
+      {
+        pConfig->m_watchTaskRunning = false;
+        break;
+      }
+    }
+
+    // files may change with slot mode or storage
+    filenames = pConfig->getWatchFilenames();
+    bool changed = false;
+#ifdef SPCONFIG_USE_INOTIFY
+    if (fd >= 0)
+    {
+      struct pollfd pfd = { fd, POLLIN, 0 };
+      if (poll(&pfd, 1, 100) > 0)
+      {
+        ssize_t len;
+        while ((len = ::read(fd, eventBuf, sizeof(eventBuf))) > 0)
+        {
+          for (char *p = eventBuf; p < eventBuf + len; p += sizeof(struct inotify_event) + ((struct inotify_event*)p)->len)
+          {
+            struct inotify_event *pEvent = (struct inotify_event*)p;
+            for (const std::string &filename : filenames)
+            {
+              if ((pEvent->len > 0) && (std::filesystem::path(filename).filename().string() == pEvent->name))
+              {
+                changed = true;
+              }
+            }
+          }
+        }
+      }
+    }
+    else
+#endif
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(SPCONFIG_WATCH_POLL_MS));
+      for (const std::string &filename : filenames)
+      {
+        spConfigFileStamp stamp = fileStamp(filename);
+        if (seenStamps[filename] != stamp)
+        {
+          seenStamps[filename] = stamp;
+          changed = true;
+        }
+      }
+    }
+
+    uint64_t nowMS = pConfig->timeSinceEpochMillisec();
+    if (changed)
+    {
+      changeTimeMS = nowMS;
+    }
+    else if ((changeTimeMS > 0) && (nowMS - changeTimeMS >= SPCONFIG_WATCH_DEBOUNCE_MS))
+    {
+      changeTimeMS = 0;
+      // files only written by save() hold the values already
+      bool changedByOthers = false;
+      for (const std::string &filename : filenames)
+      {
+        spConfigFileStamp stamp = fileStamp(filename);
+        if ((stamps[filename] != stamp) && !pConfig->isOwnSave(filename, stamp))
+        {
+          changedByOthers = true;
+        }
+        stamps[filename] = stamp;
+      }
+      if (changedByOthers)
+      {
+        pConfig->reload();
+      }
+    }
+  }
+
+#ifdef SPCONFIG_USE_INOTIFY
+  if (fd >= 0)
+  {
+    ::close(fd);
+  }
+#endif
 }
@@ -2,8 +2,8 @@
  * @file spConfig.h
  * @author krokoreit (krokoreit@gmail.com)
  * @brief class to handle configuration values and files
- * @version 2.1.3
- * @date 2024-10-23
+ * @version 2.2.0
+ * @date 2026-10-18
  * @copyright Copyright (c) 2024
  * 
  * Version history:
@@ -13,6 +13,7 @@
  * v2.1.1   replaced printf() with spLogHelper
  * v2.1.2   minor updates
  * v2.1.3   align versioning for git
+ * v2.2.0   file watch with reload() of changes made by others
  *  
  */
 
@@ -22,22 +23,40 @@
 
 
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <map>
 #include <spLogHelper.h>
 #include <spConfigBase.h>
 
 
 class spConfig : public spConfigBase {
   private:
-    std::thread *m_pLoopThread; 
+    std::thread *m_pLoopThread = nullptr;
+    std::mutex m_loopMutex;
+    bool m_loopTaskRunning = false;
+    std::thread *m_pNotifyThread = nullptr;
+    std::mutex m_notifyMutex;
+    std::condition_variable m_notifyCondition;
+    bool m_changeQueued = false;
+    bool m_notifyTaskRunning = false;
+    std::thread *m_pWatchThread = nullptr;
+    std::mutex m_watchMutex;
+    bool m_watchTaskRunning = false;
     
     // override virtuals
     void onSetChanged();
     size_t readFile(std::string filename, char* buf, size_t startPos, size_t maxBytes);
     size_t saveFile(std::string filename, char* buf, size_t startPos, size_t writeBytes);
     void ensureLoopTask();
+    void ensureNotifyTask();
+    void onChangeQueued();
+    void ensureWatchTask();
 
     uint64_t timeSinceEpochMillisec();
     static void config_loop_task(spConfig* pConfig);
+    static void config_notify_task(spConfig* pConfig);
+    static void config_watch_task(spConfig* pConfig);
 
   public:
     ~spConfig();
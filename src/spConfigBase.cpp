@@ -2,14 +2,30 @@
  * @file spConfigBase.cpp
  * @author krokoreit (krokoreit@gmail.com)
  * @brief class to handle configuration data
- * @version 2.1.3
- * @date 2024-10-23
+ * @version 2.2.0
+ * @date 2026-10-18
  * @copyright Copyright (c) 2024
  * 
  */
 
 #include <spConfigBase.h>
 #include <filesystem>
+#include <chrono>
+#include <algorithm>
+
+#ifdef SPCONFIG_WINDOWS_OS
+  #define SPCONFIG_ENVIRON _environ
+#else
+  extern char **environ;
+  #define SPCONFIG_ENVIRON environ
+#endif
+
+// call of the storage, directly without virtual dispatch, while using the storage selected at compile time
+#ifdef SPCONFIG_STORAGE
+  #define SPCONFIG_STORAGE_CALL(method, ...)  ((m_pStorage == &m_storage) ? m_storage.SPCONFIG_STORAGE::method(__VA_ARGS__) : m_pStorage->method(__VA_ARGS__))
+#else
+  #define SPCONFIG_STORAGE_CALL(method, ...)  (m_pStorage->method(__VA_ARGS__))
+#endif
 
 
 /*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
@@ -26,8 +42,12 @@
       PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
 
 
-spConfigBase::spConfigBase() : m_store(ASC)
+spConfigBase::spConfigBase() : m_pNamePool(std::make_shared<spConfigNamePool>()), m_pStore(std::make_shared<spConfigStore>(m_pNamePool)), 
+                               m_overrides(m_pNamePool), m_pDefaults(std::make_shared<spConfigDefaults>(m_pNamePool))
 {
+#ifdef SPCONFIG_STORAGE
+  m_pStorage = &m_storage;
+#endif
 }
 
 
@@ -45,23 +65,30 @@ spConfigBase::~spConfigBase()
  * @param section   name of section 
  * @param key       name of key
  * @param value     value as char*
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
  */
-void spConfigBase::setValue(const char* section, const char* key, const char* value)
+bool spConfigBase::setValue(const char* section, const char* key, const char* value)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
-  if (!cv)
-  {
-    m_store.addObjWithId(makeId(section, key), value);
-  }
-  else
+  return setValue(spConfigKey(section, key), value);
+}
+
+/**
+ * @brief setting configuration value for item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param value     value as char*
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
+ */
+bool spConfigBase::setValue(const spConfigKey &key, const char* value)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findStoredValue(key);
+  if (cv && value && cv->c_str() && (strcmp(value, cv->c_str()) == 0))
   {
-    if (value == cv->c_str())
-    {
-      return;
-    }
-    *cv = value;
+    SPCONFIG_METRIC(m_metrics.noopSets.add());
+    return true;
   }
-  setChanged();
+  return storeValue(key, value, lock);
 }
 
 /**
@@ -70,23 +97,30 @@ void spConfigBase::setValue(const char* section, const char* key, const char* va
  * @param section   name of section 
  * @param key       name of key
  * @param value     value as int32_t
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
  */
-void spConfigBase::setValue(const char* section, const char* key, int32_t value)
+bool spConfigBase::setValue(const char* section, const char* key, int32_t value)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
-  if (!cv)
-  {
-    m_store.addObjWithId(makeId(section, key), value);
-  }
-  else
+  return setValue(spConfigKey(section, key), value);
+}
+
+/**
+ * @brief setting configuration value for item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param value     value as int32_t
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
+ */
+bool spConfigBase::setValue(const spConfigKey &key, int32_t value)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findStoredValue(key);
+  if (cv && (value == cv->asInt32()))
   {
-    if (value == cv->asInt32())
-    {
-      return;
-    }
-    *cv = value;
+    SPCONFIG_METRIC(m_metrics.noopSets.add());
+    return true;
   }
-  setChanged();
+  return storeValue(key, value, lock);
 }
 
 /**
@@ -95,23 +129,30 @@ void spConfigBase::setValue(const char* section, const char* key, int32_t value)
  * @param section   name of section 
  * @param key       name of key
  * @param value     value as uint32_t
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
  */
-void spConfigBase::setValue(const char* section, const char* key, uint32_t value)
+bool spConfigBase::setValue(const char* section, const char* key, uint32_t value)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
-  if (!cv)
-  {
-    m_store.addObjWithId(makeId(section, key), value);
-  }
-  else
+  return setValue(spConfigKey(section, key), value);
+}
+
+/**
+ * @brief setting configuration value for item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param value     value as uint32_t
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
+ */
+bool spConfigBase::setValue(const spConfigKey &key, uint32_t value)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findStoredValue(key);
+  if (cv && (value == cv->asUInt32()))
   {
-    if (value == cv->asUInt32())
-    {
-      return;
-    }
-    *cv = value;
+    SPCONFIG_METRIC(m_metrics.noopSets.add());
+    return true;
   }
-  setChanged();
+  return storeValue(key, value, lock);
 }
 
 /**
@@ -120,23 +161,30 @@ void spConfigBase::setValue(const char* section, const char* key, uint32_t value
  * @param section   name of section 
  * @param key       name of key
  * @param value     value as int64_t
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
  */
-void spConfigBase::setValue(const char* section, const char* key, int64_t value)
+bool spConfigBase::setValue(const char* section, const char* key, int64_t value)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
-  if (!cv)
-  {
-    m_store.addObjWithId(makeId(section, key), value);
-  }
-  else
+  return setValue(spConfigKey(section, key), value);
+}
+
+/**
+ * @brief setting configuration value for item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param value     value as int64_t
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
+ */
+bool spConfigBase::setValue(const spConfigKey &key, int64_t value)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findStoredValue(key);
+  if (cv && (value == cv->asInt64()))
   {
-    if (value == cv->asInt64())
-    {
-      return;
-    }
-    *cv = value;
+    SPCONFIG_METRIC(m_metrics.noopSets.add());
+    return true;
   }
-  setChanged();
+  return storeValue(key, value, lock);
 }
 
 /**
@@ -145,23 +193,30 @@ void spConfigBase::setValue(const char* section, const char* key, int64_t value)
  * @param section   name of section 
  * @param key       name of key
  * @param value     value as uint64_t
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
  */
-void spConfigBase::setValue(const char* section, const char* key, uint64_t value)
+bool spConfigBase::setValue(const char* section, const char* key, uint64_t value)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
-  if (!cv)
-  {
-    m_store.addObjWithId(makeId(section, key), value);
-  }
-  else
+  return setValue(spConfigKey(section, key), value);
+}
+
+/**
+ * @brief setting configuration value for item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param value     value as uint64_t
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
+ */
+bool spConfigBase::setValue(const spConfigKey &key, uint64_t value)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findStoredValue(key);
+  if (cv && (value == cv->asUInt64()))
   {
-    if (value == cv->asUInt64())
-    {
-      return;
-    }
-    *cv = value;
+    SPCONFIG_METRIC(m_metrics.noopSets.add());
+    return true;
   }
-  setChanged();
+  return storeValue(key, value, lock);
 }
 
 /**
@@ -170,23 +225,30 @@ void spConfigBase::setValue(const char* section, const char* key, uint64_t value
  * @param section   name of section 
  * @param key       name of key
  * @param value     value as double
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
  */
-void spConfigBase::setValue(const char* section, const char* key, double value)
+bool spConfigBase::setValue(const char* section, const char* key, double value)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
-  if (!cv)
-  {
-    m_store.addObjWithId(makeId(section, key), value);
-  }
-  else
+  return setValue(spConfigKey(section, key), value);
+}
+
+/**
+ * @brief setting configuration value for item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param value     value as double
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
+ */
+bool spConfigBase::setValue(const spConfigKey &key, double value)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findStoredValue(key);
+  if (cv && (value == cv->asDouble()))
   {
-    if (value == cv->asDouble())
-    {
-      return;
-    }
-    *cv = value;
+    SPCONFIG_METRIC(m_metrics.noopSets.add());
+    return true;
   }
-  setChanged();
+  return storeValue(key, value, lock);
 }
 
 /**
@@ -195,27 +257,36 @@ void spConfigBase::setValue(const char* section, const char* key, double value)
  * @param section   name of section 
  * @param key       name of key
  * @param value     value as bool
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
  */
-void spConfigBase::setValue(const char* section, const char* key, bool value)
+bool spConfigBase::setValue(const char* section, const char* key, bool value)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
-  if (!cv)
-  {
-    m_store.addObjWithId(makeId(section, key), value);
-  }
-  else
+  return setValue(spConfigKey(section, key), value);
+}
+
+/**
+ * @brief setting configuration value for item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param value     value as bool
+ * @return true / false  for value stored, false when frozen or exceeding memory limits
+ */
+bool spConfigBase::setValue(const spConfigKey &key, bool value)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findStoredValue(key);
+  if (cv && (value == cv->asBool()))
   {
-    if (value == cv->asBool())
-    {
-      return;
-    }
-    *cv = value;
+    SPCONFIG_METRIC(m_metrics.noopSets.add());
+    return true;
   }
-  setChanged();
+  return storeValue(key, value, lock);
 }
 
 /**
- * @brief get configuration value object
+ * @brief get configuration value object, the pointer remains valid until any value of the config 
+ *        object is changed, i.e. while getGeneration() returns the same number, so with other threads 
+ *        changing values, use the get...() functions copying the value instead
  * 
  * @param section   name of section 
  * @param key       name of key
@@ -223,7 +294,19 @@ void spConfigBase::setValue(const char* section, const char* key, bool value)
  */
 spConfigValue* spConfigBase::getConfigValue(const char* section, const char* key)
 {
-  spConfigValue* cv = m_store.getObjById(makeId(section, key));
+  return getConfigValue(spConfigKey(section, key));
+}
+
+/**
+ * @brief get configuration value object for section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @return spConfigValue*   pointer to object
+ */
+spConfigValue* spConfigBase::getConfigValue(const spConfigKey &key)
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue* cv = findValue(key);
   if (!cv)
   {
     return &m_non_existant_configValue;
@@ -232,7 +315,8 @@ spConfigValue* spConfigBase::getConfigValue(const char* section, const char* key
 }
 
 /**
- * @brief return the value of item with given section and key parameters
+ * @brief return the value of item with given section and key parameters, the pointer remains valid
+ *        until any value of the config object is changed, see getConfigValue()
  * 
  * @param section   name of section 
  * @param key       name of key
@@ -241,7 +325,20 @@ spConfigValue* spConfigBase::getConfigValue(const char* section, const char* key
  */
 const char* spConfigBase::getCStr(const char* section, const char* key, const char* defaultValue)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
+  return getCStr(spConfigKey(section, key), defaultValue);
+}
+
+/**
+ * @brief return the value of item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param defaultValue  value to use if no entry under section / key
+ * @return const char*  value as char*
+ */
+const char* spConfigBase::getCStr(const spConfigKey &key, const char* defaultValue)
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findValue(key);
   if (cv)
   {
     return cv->c_str();
@@ -259,7 +356,20 @@ const char* spConfigBase::getCStr(const char* section, const char* key, const ch
  */
 std::string spConfigBase::getString(const char* section, const char* key, const char* defaultValue)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
+  return getString(spConfigKey(section, key), defaultValue);
+}
+
+/**
+ * @brief return the value of item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param defaultValue  value to use if no entry under section / key
+ * @return std::string  value as std::string
+ */
+std::string spConfigBase::getString(const spConfigKey &key, const char* defaultValue)
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findValue(key);
   if (cv)
   {
     return cv->asString();
@@ -277,7 +387,20 @@ std::string spConfigBase::getString(const char* section, const char* key, const
  */
 int32_t spConfigBase::getInt32(const char* section, const char* key, int32_t defaultValue)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
+  return getInt32(spConfigKey(section, key), defaultValue);
+}
+
+/**
+ * @brief return the value of item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param defaultValue  value to use if no entry under section / key
+ * @return int32_t  value as int32_t
+ */
+int32_t spConfigBase::getInt32(const spConfigKey &key, int32_t defaultValue)
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findValue(key);
   if (cv)
   {
     return cv->asInt32();
@@ -293,9 +416,22 @@ int32_t spConfigBase::getInt32(const char* section, const char* key, int32_t def
  * @param defaultValue  value to use if no entry under section / key
  * @return const char*  value as uint32_t
  */
-int32_t spConfigBase::getUInt32(const char* section, const char* key, uint32_t defaultValue)
+uint32_t spConfigBase::getUInt32(const char* section, const char* key, uint32_t defaultValue)
+{
+  return getUInt32(spConfigKey(section, key), defaultValue);
+}
+
+/**
+ * @brief return the value of item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param defaultValue  value to use if no entry under section / key
+ * @return uint32_t  value as uint32_t
+ */
+uint32_t spConfigBase::getUInt32(const spConfigKey &key, uint32_t defaultValue)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findValue(key);
   if (cv)
   {
     return cv->asUInt32();
@@ -313,12 +449,25 @@ int32_t spConfigBase::getUInt32(const char* section, const char* key, uint32_t d
  */
 int64_t spConfigBase::getInt64(const char* section, const char* key, int64_t defaultValue)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
+  return getInt64(spConfigKey(section, key), defaultValue);
+}
+
+/**
+ * @brief return the value of item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param defaultValue  value to use if no entry under section / key
+ * @return int64_t  value as int64_t
+ */
+int64_t spConfigBase::getInt64(const spConfigKey &key, int64_t defaultValue)
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findValue(key);
   if (cv)
   {
     return cv->asInt64();
   } 
-  return defaultValue;  
+  return defaultValue;
 }
 
 /**
@@ -329,9 +478,22 @@ int64_t spConfigBase::getInt64(const char* section, const char* key, int64_t def
  * @param defaultValue  value to use if no entry under section / key
  * @return const char*  value as uint64_t
  */
-int64_t spConfigBase::getUInt64(const char* section, const char* key, uint64_t defaultValue)
+uint64_t spConfigBase::getUInt64(const char* section, const char* key, uint64_t defaultValue)
+{
+  return getUInt64(spConfigKey(section, key), defaultValue);
+}
+
+/**
+ * @brief return the value of item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param defaultValue  value to use if no entry under section / key
+ * @return uint64_t  value as uint64_t
+ */
+uint64_t spConfigBase::getUInt64(const spConfigKey &key, uint64_t defaultValue)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findValue(key);
   if (cv)
   {
     return cv->asUInt64();
@@ -349,7 +511,20 @@ int64_t spConfigBase::getUInt64(const char* section, const char* key, uint64_t d
  */
 double spConfigBase::getDouble(const char* section, const char* key, double defaultValue)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
+  return getDouble(spConfigKey(section, key), defaultValue);
+}
+
+/**
+ * @brief return the value of item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param defaultValue  value to use if no entry under section / key
+ * @return double  value as double
+ */
+double spConfigBase::getDouble(const spConfigKey &key, double defaultValue)
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findValue(key);
   if (cv)
   {
     return cv->asDouble();
@@ -367,7 +542,20 @@ double spConfigBase::getDouble(const char* section, const char* key, double defa
  */
 bool spConfigBase::getBool(const char* section, const char* key, bool defaultValue)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
+  return getBool(spConfigKey(section, key), defaultValue);
+}
+
+/**
+ * @brief return the value of item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @param defaultValue  value to use if no entry under section / key
+ * @return bool  value as bool
+ */
+bool spConfigBase::getBool(const spConfigKey &key, bool defaultValue)
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findValue(key);
   if (cv)
   {
     return cv->asBool();
@@ -384,314 +572,2236 @@ bool spConfigBase::getBool(const char* section, const char* key, bool defaultVal
  */
 bool spConfigBase::exists(const char* section, const char* key)
 {
-  spConfigValue *cv = m_store.getObjById(makeId(section, key));
-  return (cv != nullptr);
+  return exists(spConfigKey(section, key));
 }
 
 /**
- * @brief returns whether the config object holds any changed and not yet saved values
+ * @brief returns whether an item with given section and key exists, e.g. from SPCONFIG_KEY()
  * 
+ * @param key       section and key with hash
  * @return true / false 
  */
-bool spConfigBase::changed()
+bool spConfigBase::exists(const spConfigKey &key)
 {
-  return m_hasChanged;
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = findValue(key);
+  return (cv != nullptr);
 }
 
 /**
- * @brief reset configuration to either 'filename-default.ini' or to an empty list, if no default file exists
+ * @brief call the callback for each value in the section as returned by the getters, i.e. with
+ *        override, stored and default values combined, in ascending order of keys
+ *        the values cannot be changed while the callback is running, so it must not call setValue() etc.
  * 
+ * @param section   name of section 
+ * @param callback  function called with key and value, returning false to stop
  */
-void spConfigBase::reset()
+void spConfigBase::forEachInSection(const char* section, std::function<bool(const char* key, const spConfigValue &value)> callback)
 {
-  if (!canUseFS())
+  typedef std::vector<std::pair<const char*, const spConfigValue*>> SectionEntries;
+  SectionEntries layers[3];
+
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  auto collect = [](SectionEntries &entries) {
+    return [&entries](const char* key, const spConfigValue &cv) {
+      entries.push_back(std::make_pair(key, &cv));
+      return true;
+    };
+  };
+  // in order of precedence
+  if (m_hasOverrides)
   {
-    return;
+    m_overrides.forEachInSection(section, collect(layers[0]));
   }
-  m_store.reset();
-  save();
+  m_pStore->forEachInSection(section, collect(layers[1]));
+  m_pDefaults->m_store.forEachInSection(section, collect(layers[2]));
 
-  // read defaults
-  if (parseIniFile(m_configDefaultFilename))
+  // merge sorted layers, taking the value of the first layer with the key
+  size_t pos[3] = { 0, 0, 0 };
+  while (true)
   {
-    m_hasChanged = true; // force save
-    save();
+    int next = -1;
+    for (int i = 0; i < 3; i++)
+    {
+      if ((pos[i] < layers[i].size()) && ((next < 0) || (strcmp(layers[i][pos[i]].first, layers[next][pos[next]].first) < 0)))
+      {
+        next = i;
+      }
+    }
+    if (next < 0)
+    {
+      break;
+    }
+    const char* key = layers[next][pos[next]].first;
+    if (!callback(key, *layers[next][pos[next]].second))
+    {
+      break;
+    }
+    // skip same key in layers with lower precedence
+    for (int i = next + 1; i < 3; i++)
+    {
+      if ((pos[i] < layers[i].size()) && (strcmp(layers[i][pos[i]].first, key) == 0))
+      {
+        pos[i]++;
+      }
+    }
+    pos[next]++;
   }
-  m_hasChanged = false;
 }
 
-
 /**
- * @brief try to read configuration data from 'config-default.ini' file and 'config.ini' file
+ * @brief call the callback for each section with any override, stored or default value, 
+ *        in ascending order of sections
+ *        the values cannot be changed while the callback is running, so it must not call setValue() etc.
  * 
+ * @param callback  function called with name of section, returning false to stop
  */
-void spConfigBase::read(){
-
-  if (!canUseFS())
+void spConfigBase::forEachSection(std::function<bool(const char* section)> callback)
+{
+  std::vector<const char*> layers[3];
+
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  auto collect = [](std::vector<const char*> &sections) {
+    return [&sections](const char* section) {
+      sections.push_back(section);
+      return true;
+    };
+  };
+  if (m_hasOverrides)
   {
-    return;
+    m_overrides.forEachSection(collect(layers[0]));
   }
+  m_pStore->forEachSection(collect(layers[1]));
+  m_pDefaults->m_store.forEachSection(collect(layers[2]));
 
-  m_store.reset();
-  parseIniFile(m_configDefaultFilename);
-  if (!parseIniFile(m_configFilename))
+  // merge sorted layers, skipping sections found in more than one layer
+  size_t pos[3] = { 0, 0, 0 };
+  while (true)
   {
-    m_hasChanged = true; // force save
-    save();
+    int next = -1;
+    for (int i = 0; i < 3; i++)
+    {
+      if ((pos[i] < layers[i].size()) && ((next < 0) || (strcmp(layers[i][pos[i]], layers[next][pos[next]]) < 0)))
+      {
+        next = i;
+      }
+    }
+    if (next < 0)
+    {
+      break;
+    }
+    const char* section = layers[next][pos[next]];
+    if (!callback(section))
+    {
+      break;
+    }
+    for (int i = next + 1; i < 3; i++)
+    {
+      if ((pos[i] < layers[i].size()) && (strcmp(layers[i][pos[i]], section) == 0))
+      {
+        pos[i]++;
+      }
+    }
+    pos[next]++;
   }
-  m_hasChanged = false;
 }
 
 /**
- * @brief save configuration values to the 'config.ini' file when values have previously been changed 
+ * @brief remove the stored value of the item with given section and key parameters, so its default 
+ *        value applies again, if there is one, and it is no longer saved
  * 
+ * @param section   name of section 
+ * @param key       name of key
+ * @return true / false  for stored value found and removed
  */
-void spConfigBase::save()
+bool spConfigBase::removeValue(const char* section, const char* key)
 {
-  if (!m_hasChanged || !canUseFS())
+  return removeValue(spConfigKey(section, key));
+}
+
+/**
+ * @brief remove the stored value of the item with given section and key, e.g. from SPCONFIG_KEY()
+ * 
+ * @param key       section and key with hash
+ * @return true / false  for stored value found and removed
+ */
+bool spConfigBase::removeValue(const spConfigKey &key)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  spConfigValue *cv = m_pStore->find(key);
+  if (!cv || rejectFrozen("removeValue"))
   {
-    return;
+    return false;
   }
-
-  if (!ensureFileBuffer())
+  bool notify = m_notifier.hasSubscribers();
+  spConfigValue oldValue;
+  if (notify)
   {
-    spLOG_E("spConfigBase::save() aborted");
-    return;
+    oldValue = *cv;
   }
-
-  // start of file & buffer
-  m_fPos = 0;
-  m_fileBufUsed = 0;
-
-  m_filenameUsed = m_configFilePath + m_configFilename;
-  if (m_configFileExtension.length() > 0)
+  m_pStore->remove(key);
+  markDirty(key);
+  compactStore();
+  spConfigValue *pDefault = m_pDefaults->find(key);
+  spConfigValue newValue;
+  if (notify && pDefault)
   {
-    m_filenameUsed.append(".");
-    m_filenameUsed.append(m_configFileExtension);
+    newValue = *pDefault;
   }
-  spLOGF_D("saving %s", m_filenameUsed.c_str());
+  nextGeneration();
+  lock.unlock();
+  setChanged();
+
+  if (notify && !(pDefault && (strcmp(oldValue.c_str(), newValue.c_str()) == 0)))
+  {
+    notifyChange(key, &oldValue, pDefault ? &newValue : nullptr);
+  }
+  return true;
+}
 
-  // init collection vars
-  m_lastSection = "";
+/**
+ * @brief remove all stored values of a section, so their default values apply again, if there are any
+ *        takes time proportional to the number of values in the section only
+ * 
+ * @param section   name of section 
+ * @return size_t  number of stored values removed
+ */
+size_t spConfigBase::removeSection(const char* section)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  if (rejectFrozen("removeSection"))
+  {
+    return 0;
+  }
+  // keys with old and new values for subscribers
+  std::vector<std::pair<std::string, std::pair<spConfigValue, const spConfigValue*>>> removed;
+  bool notify = m_notifier.hasSubscribers();
+  spConfigDefaults *pDefaults = m_pDefaults.get();
+  m_pStore->forEachInSection(section, [this, section, notify, pDefaults, &removed](const char* key, const spConfigValue &cv) {
+    spConfigKey removedKey(section, key);
+    markDirty(removedKey);
+    if (notify)
+    {
+      removed.push_back(std::make_pair(std::string(key), std::make_pair(cv, pDefaults->find(removedKey))));
+    }
+    return true;
+  });
+  size_t count = m_pStore->removeSection(section);
+  if (count == 0)
+  {
+    return 0;
+  }
+  compactStore();
+  // defaults layer is kept alive for the notifications
+  std::shared_ptr<spConfigDefaults> pKeepDefaults = m_pDefaults;
+  nextGeneration();
+  lock.unlock();
+  setChanged();
 
-  // callback, link non-static function to have access to non-static members, i.e. the spConfigBase object
-  m_store.forEach(std::bind(&spConfigBase::saveIniEntryCB, this, std::placeholders::_1, std::placeholders::_2));
+  for (auto &entry : removed)
+  {
+    const spConfigValue &oldValue = entry.second.first;
+    const spConfigValue *pNewValue = entry.second.second;
+    if (!pNewValue || (strcmp(oldValue.c_str(), pNewValue->c_str()) != 0))
+    {
+      notifyChange(spConfigKey(section, entry.first.c_str()), &oldValue, pNewValue);
+    }
+  }
+  return count;
+}
 
-  // final write
-  saveFile(m_filenameUsed, m_pFileBuf, m_fPos, m_fileBufUsed);
+/**
+ * @brief return the pool holding each distinct section and key name once, e.g. to share it with 
+ *        other config objects using mostly the same names
+ * 
+ * @return spConfigNamePoolPtr  reference counted name pool
+ */
+spConfigNamePoolPtr spConfigBase::getNamePool()
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  return m_pNamePool;
+}
 
-  // release buffer
-  freeFileBuffer();
+/**
+ * @brief use a name pool shared with other config objects for all values loaded thereafter by 
+ *        read(), reset(), reload() and setDefaults(), i.e. best called before read()
+ *        a nullptr creates a new pool for this config object
+ * 
+ * @param pNames  reference counted name pool or nullptr
+ */
+void spConfigBase::setNamePool(spConfigNamePoolPtr pNames)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  m_pNamePool = pNames ? pNames : std::make_shared<spConfigNamePool>();
+}
 
-  m_hasChanged = false;
+/**
+ * @brief return the memory resource used for the arenas of loaded values or nullptr, if not used
+ * 
+ * @return std::pmr::memory_resource* 
+ */
+std::pmr::memory_resource* spConfigBase::getMemoryResource()
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  return m_pMemoryResource;
 }
 
+/**
+ * @brief load all values read by read(), reset(), reload() and setDefaults() thereafter into an arena 
+ *        per store, which takes memory in blocks from the memory resource and releases it all at once, 
+ *        when the store is replaced, instead of allocating and freeing each value individually
+ *        values added or removed later leave memory in the arena, so the store is replaced by a compact 
+ *        copy, once more than SPCONFIG_ARENA_COMPACT_MIN bytes and more than the values take are unused
+ *        the resource must outlive the config object and be thread safe, when shared with others
+ *        a nullptr reverts to individual allocations
+ * 
+ * @param pResource  e.g. std::pmr::new_delete_resource() or nullptr
+ */
+void spConfigBase::setMemoryResource(std::pmr::memory_resource* pResource)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  m_pMemoryResource = pResource;
+}
 
 /**
- * @brief set autosave mode and return previous mode
+ * @brief keep the values and names loaded thereafter by read(), reset(), reload() and setDefaults() together 
+ *        with their index in fixed memory, e.g. on static storage, instead of the heap, with each store 
+ *        holding at most capacity values, all memory is checked before it is taken, so exceeding limits 
+ *        makes setValue(), read(), reset() and reload() fail and is reported as error
+ *        the memory must hold up to three generations of values and defaults, as while read() loads new ones
+ *        overrides, frozen tables, subscriptions, file names and the file buffer remain on the heap
+ *        a nullptr reverts to heap memory, with setMemoryResource() applying again
  * 
- * @param autosave true or false
- * @return true or false
+ * @param pMemory  fixed memory or nullptr
+ * @param capacity  maximum number of values per store, at least 1
+ * @return true / false  for success
  */
-bool spConfigBase::setAutosave(bool autosave)
+bool spConfigBase::setFixedMemory(spConfigFixedMemory* pMemory, size_t capacity)
 {
-  bool oldAutosave = m_autosave;
-  if (m_autosave != autosave)
+  if (pMemory && (capacity == 0))
   {
-    m_autosave = autosave;
-    if (oldAutosave)
-    {
-      // ensure we have no unsaved stuff
-      save();
-    }
-    else 
+    spLOG_E("spConfigBase::setFixedMemory() requires a capacity of at least one value");
+    return false;
+  }
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  // a new pool for names in the same memory, as the current one may be shared
+  if (pMemory)
+  {
+    std::lock_guard<spConfigFixedMemory> memoryLock(*pMemory);
+    size_t sizes[] = { sizeof(spConfigNamePool) + SPCONFIG_SHARED_OVERHEAD, spConfigNamePool::indexBytes() };
+    if (!pMemory->fits(sizes, 2))
     {
-      // ensure we have a looptask
-      ensureLoopTask();
+      spLOG_E("spConfigBase::setFixedMemory() failed, as fixed memory is too small");
+      return false;
     }
+    m_pNamePool = std::allocate_shared<spConfigNamePool>(std::pmr::polymorphic_allocator<spConfigNamePool>(pMemory), pMemory);
   }
-  return oldAutosave;
+  else
+  {
+    m_pNamePool = std::make_shared<spConfigNamePool>();
+  }
+  m_pFixedMemory = pMemory;
+  m_fixedCapacity = pMemory ? capacity : 0;
+  return true;
 }
 
+/**
+ * @brief return the estimated memory of all values by section, of the hash tables and of the name pool, 
+ *        with the memory counted against the budget
+ * 
+ * @return spConfigMemoryUsage 
+ */
+spConfigMemoryUsage spConfigBase::memoryUsage()
+{
+  spConfigMemoryUsage usage;
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  if (m_hasOverrides)
+  {
+    m_overrides.memoryUsage(usage);
+  }
+  m_pStore->memoryUsage(usage);
+  m_pDefaults->m_store.memoryUsage(usage);
+  usage.namePool = m_pStore->getNamePool()->bytes();
+  usage.budget = m_memoryBudget;
+  usage.budgetUsed = m_pStore->memoryUsed() + m_pDefaults->m_store.memoryUsed();
+  return usage;
+}
 
 /**
- * @brief return status of autosave
+ * @brief return the memory budget or 0 for none
  * 
- * @return true / false 
+ * @return size_t 
  */
-bool spConfigBase::getAutosave()
+size_t spConfigBase::getMemoryBudget()
 {
-  return m_autosave;
+  return m_memoryBudget;
 }
 
+/**
+ * @brief set a budget for the estimated memory of stored values and defaults, see memoryUsage(), 
+ *        setValue() then keeps the current value and read() and reload() keep all current values, 
+ *        when the budget would be exceeded, while values already stored are kept when lowering it
+ * 
+ * @param bytes  budget or 0 for none
+ */
+void spConfigBase::setMemoryBudget(size_t bytes)
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  m_memoryBudget = bytes;
+  m_pStore->setMemoryLimit(storeBudget(m_pDefaults.get()));
+}
 
 /**
- * @brief set name of the configuration file, the standard is 'config'
+ * @brief return a copy of the counters of lookups, sets, reads and saves, all 0 with SPCONFIG_NO_METRICS defined,
+ *        e.g. for spConfigMetrics::toPrometheus()
  * 
- * @param newName 
+ * @return spConfigMetricsSnapshot 
  */
-void spConfigBase::setConfigFilename(std::string newName)
+spConfigMetricsSnapshot spConfigBase::getMetrics()
 {
-  if (newName.length() > 0)
+  spConfigMetricsSnapshot snapshot;
+  SPCONFIG_METRIC(m_metrics.snapshot(snapshot));
+  return snapshot;
+}
+
+/**
+ * @brief set all counters of lookups, sets, reads and saves to 0
+ * 
+ */
+void spConfigBase::resetMetrics()
+{
+  SPCONFIG_METRIC(m_metrics.reset());
+}
+
+/**
+ * @brief set a function to receive an event for each phase of reading and saving, e.g. the callback() of 
+ *        spConfigChromeTrace, or nullptr to stop tracing, the function must not access the config object
+ * 
+ * @param callback  function receiving events or nullptr
+ */
+void spConfigBase::setTraceCallback(spConfigTraceCallback callback)
+{
+  m_tracer.setCallback(callback);
+}
+
+/**
+ * @brief set profiling mode to count the reads of each value by the getters and return previous mode
+ *        counts are kept when profiling is stopped and cleared by read(), reset() and resetProfile()
+ * 
+ * @param profiling  true or false
+ * @param sampleRate  count only every n-th read of each thread, adding n, which reduces the overhead
+ *                    for hot keys, but turns the counts into estimates, 1 to count every read
+ * @return true / false  for previous mode
+ */
+bool spConfigBase::setProfiling(bool profiling, uint32_t sampleRate)
+{
+  if (profiling)
   {
-    m_configFilename = newName;
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    m_profile.allocate();
+    m_profile.setSampleRate(sampleRate);
   }
+  return m_profiling.exchange(profiling);
 }
 
 /**
- * @brief return the name of the configuration file
+ * @brief return profiling mode
  * 
- * @return std::string 
+ * @return true / false 
  */
-std::string spConfigBase::getConfigFilename()
+bool spConfigBase::getProfiling()
 {
-  return m_configFilename;
+  return m_profiling;
 }
 
 /**
- * @brief set name of the default configuration file, the standard is 'config-default'
+ * @brief return the most read values with their number of reads, highest first, from all values in 
+ *        overrides, stored values and defaults, e.g. to use spConfigCached or SPCONFIG_KEY() for them
  * 
- * @param newName 
+ * @param count  maximum number of values returned
+ * @return std::vector<spConfigKeyReads>  values read at least once
  */
-void spConfigBase::setConfigDefaultFilename(std::string newName)
+std::vector<spConfigKeyReads> spConfigBase::getHotKeys(size_t count)
 {
-  if (newName.length() > 0)
+  std::vector<spConfigKeyReads> keys;
+  collectKeyReads(keys);
+  keys.erase(std::remove_if(keys.begin(), keys.end(), [](const spConfigKeyReads &k) { return k.reads == 0; }), keys.end());
+  std::stable_sort(keys.begin(), keys.end(), [](const spConfigKeyReads &k1, const spConfigKeyReads &k2) { return k1.reads > k2.reads; });
+  if (keys.size() > count)
   {
-    m_configDefaultFilename = newName;
+    keys.resize(count);
   }
+  return keys;
 }
 
 /**
- * @brief return the name of the default configuration file
+ * @brief return the values in overrides, stored values and defaults, which have not been read since 
+ *        profiling started or the last read(), reset() or resetProfile(), ordered by section and key, 
+ *        e.g. to remove them from the config files
  * 
- * @return std::string 
+ * @return std::vector<spConfigKeyReads>  values with reads of 0
  */
-std::string spConfigBase::getConfigDefaultFilename()
+std::vector<spConfigKeyReads> spConfigBase::getUnusedKeys()
 {
-  return m_configDefaultFilename;
+  std::vector<spConfigKeyReads> keys;
+  collectKeyReads(keys);
+  keys.erase(std::remove_if(keys.begin(), keys.end(), [](const spConfigKeyReads &k) { return k.reads > 0; }), keys.end());
+  return keys;
 }
 
 /**
- * @brief set extension of the configuration file, the standard is 'ini'
+ * @brief return the reads not counted by key, as more than SPCONFIG_PROFILE_SLOTS different keys 
+ *        were read, if not 0, some keys listed by getUnusedKeys() may have been read
  * 
- * @param newExtension 
+ * @return uint64_t 
  */
-void spConfigBase::setConfigFileExtension(std::string newExtension)
+uint64_t spConfigBase::getUncountedReads()
 {
-  if (newExtension.length() > 0)
+  return m_profile.overflow();
+}
+
+/**
+ * @brief set the reads of all values to 0
+ * 
+ */
+void spConfigBase::resetProfile()
+{
+  m_profile.clear();
+}
+
+/**
+ * @brief return the storage used for file access or nullptr, if files are accessed by readFile() and saveFile()
+ * 
+ * @return spConfigStorage* 
+ */
+spConfigStorage* spConfigBase::getStorage()
+{
+  std::lock_guard<std::mutex> lock(m_fileMutex);
+  return m_pStorage;
+}
+
+/**
+ * @brief access files through a storage, e.g. spConfigPosixStorage, spConfigMmapStorage or spConfigMemoryStorage, 
+ *        which keeps files open while reading them and saves to a temporary file, which is synced and then 
+ *        renamed to replace the configuration file, so an interrupted save leaves the previous file intact
+ *        the storage must outlive the config object, a nullptr reverts to readFile() and saveFile()
+ * 
+ * @param pStorage  storage or nullptr
+ */
+void spConfigBase::setStorage(spConfigStorage* pStorage)
+{
+  std::lock_guard<std::mutex> lock(m_fileMutex);
+  m_pStorage = pStorage;
+}
+
+/**
+ * @brief return the defaults layer, e.g. to share it with other config objects
+ * 
+ * @return spConfigDefaultsPtr  reference counted, read-only defaults
+ */
+spConfigDefaultsPtr spConfigBase::getDefaults()
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  return m_pDefaults;
+}
+
+/**
+ * @brief use a shared defaults layer instead of reading the default configuration file,
+ *        e.g. as obtained by getDefaults() from another config object after read()
+ *        a nullptr reverts to reading the default configuration file
+ * 
+ * @param pDefaults  reference counted, read-only defaults or nullptr
+ */
+void spConfigBase::setDefaults(spConfigDefaultsPtr pDefaults)
+{
+  // replaced defaults are released after unlocking
+  std::shared_ptr<spConfigDefaults> pOldDefaults;
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  if (rejectFrozen("setDefaults"))
   {
-    m_configFileExtension = newExtension;
+    return;
   }
+  // defaults are never modified once published, see stageDefaults()
+  std::shared_ptr<spConfigDefaults> pNewDefaults = pDefaults ? std::const_pointer_cast<spConfigDefaults>(pDefaults) : newDefaults();
+  if (!pNewDefaults)
+  {
+    return;
+  }
+  pOldDefaults = m_pDefaults;
+  m_pDefaults = pNewDefaults;
+  m_pDefaultTable = nullptr;
+  m_defaultTableCount = 0;
+  m_sharedDefaults = (pDefaults != nullptr);
+  m_pStore->setMemoryLimit(storeBudget(m_pDefaults.get()));
+  nextGeneration();
 }
 
 /**
- * @brief return the extension of the configuration file
+ * @brief use a default table compiled into the binary as the defaults layer, which needs no parsing 
+ *        and no file access, e.g. as generated by spconfig_embed_defaults() in spConfigEmbedDefaults.cmake
+ *        values in a default configuration file found by read() or reset() replace those of the table
+ *        the table must remain valid while used by the config object
  * 
- * @return std::string 
+ * @param table  array of entries
+ * @param count  number of entries
  */
-std::string spConfigBase::getConfigFileExtension()
+void spConfigBase::setDefaults(const spConfigDefaultEntry* table, size_t count)
 {
-  return m_configFileExtension;
+  std::shared_ptr<spConfigDefaults> pDefaults;
+  {
+    std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+    pDefaults = newDefaults();
+  }
+  if (!pDefaults)
+  {
+    return;
+  }
+  pDefaults->m_store.setMemoryLimit(m_memoryBudget);
+  if (!pDefaults->addTable(table, count))
+  {
+    spLOG_E("spConfigBase::setDefaults() keeping current defaults, as the table exceeds memory limits");
+    return;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  if (rejectFrozen("setDefaults"))
+  {
+    return;
+  }
+  m_pDefaultTable = table;
+  m_defaultTableCount = count;
+  // replaced defaults are released with pDefaults after unlocking
+  pDefaults.swap(m_pDefaults);
+  m_sharedDefaults = false;
+  m_pStore->setMemoryLimit(storeBudget(m_pDefaults.get()));
+  nextGeneration();
 }
 
+/**
+ * @brief set an override value, which takes precedence over stored and default values,
+ *        but is never saved, e.g. for container specific settings
+ *        subscribers are notified, when the value returned by the getters changes
+ * 
+ * @param section   name of section 
+ * @param key       name of key
+ * @param value     value as char*
+ */
+void spConfigBase::setOverride(const char* section, const char* key, const char* value)
+{
+  ValueMap overrides;
+  overrides[std::make_pair(std::string(section ? section : ""), std::string(key ? key : ""))] = value ? value : "";
+  applyOverrides(overrides);
+}
 
 /**
- * @brief set the path of the configuration file, the standard is an empty string, meaning 
- *        the files are located in the application directory
+ * @brief add override values from environment variables named prefix + section + '__' + key,
+ *        e.g. APP_system__startCounterToday=6 for prefix APP_, all at once with a single new generation
  * 
- * @param newPath 
+ * @param prefix  prefix of environment variables to use
+ * @param envp    environment as given to main() or nullptr for the process environment
+ * @return size_t  number of override values added
  */
-void spConfigBase::setConfigFilePath(std::string newPath)
+size_t spConfigBase::addEnvOverrides(const char* prefix, char** envp)
 {
-  size_t len = newPath.length();
-  if (len > 0)
+  if (envp == nullptr)
+  {
+    envp = SPCONFIG_ENVIRON;
+  }
+  if ((envp == nullptr) || (prefix == nullptr))
   {
+    return 0;
+  }
 
-#ifdef SPCONFIG_WINDOWS_OS
-    // set preferred separator on Windows
-    for (size_t i = 0; i < len; i++)
+  size_t prefixLen = strlen(prefix);
+  size_t count = 0;
+  ValueMap overrides;
+  for (char** pEnv = envp; *pEnv != nullptr; pEnv++)
+  {
+    const char* entry = *pEnv;
+    if (strncmp(entry, prefix, prefixLen) != 0)
     {
-      if (newPath[i] == '/')
+      continue;
+    }
+    const char* name = entry + prefixLen;
+    const char* equalSign = strchr(name, '=');
+    if (equalSign == nullptr)
+    {
+      continue;
+    }
+    std::string nameStr(name, equalSign - name);
+    size_t sepPos = nameStr.find("__");
+    if ((sepPos == std::string::npos) || (sepPos == 0) || (sepPos + 2 >= nameStr.length()))
+    {
+      spLOGF_D("spConfigBase::addEnvOverrides() skipping %s, not in %sSECTION__KEY format", entry, prefix);
+      continue;
+    }
+    overrides[std::make_pair(nameStr.substr(0, sepPos), nameStr.substr(sepPos + 2))] = equalSign + 1;
+    count++;
+  }
+  applyOverrides(overrides);
+  return count;
+}
+
+/**
+ * @brief add override values from command line arguments in the format --section.key=value,
+ *        all at once with a single new generation, arguments in other formats are ignored
+ * 
+ * @param argc  number of arguments as given to main()
+ * @param argv  arguments as given to main()
+ * @return size_t  number of override values added
+ */
+size_t spConfigBase::addArgOverrides(int argc, char* argv[])
+{
+  size_t count = 0;
+  ValueMap overrides;
+  for (int i = 1; i < argc; i++)
+  {
+    const char* arg = argv[i];
+    if ((arg == nullptr) || (strncmp(arg, "--", 2) != 0))
+    {
+      continue;
+    }
+    const char* equalSign = strchr(arg + 2, '=');
+    if (equalSign == nullptr)
+    {
+      continue;
+    }
+    // last dot before '=' separates section from key, so sections may contain dots
+    std::string name(arg + 2, equalSign - arg - 2);
+    size_t dotPos = name.rfind('.');
+    if ((dotPos == std::string::npos) || (dotPos == 0) || (dotPos + 1 >= name.length()))
+    {
+      continue;
+    }
+    overrides[std::make_pair(name.substr(0, dotPos), name.substr(dotPos + 1))] = equalSign + 1;
+    count++;
+  }
+  applyOverrides(overrides);
+  return count;
+}
+
+/**
+ * @brief remove all override values, subscribers are notified about the values returned thereafter
+ * 
+ */
+void spConfigBase::clearOverrides()
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  if (!m_hasOverrides || rejectFrozen("clearOverrides"))
+  {
+    return;
+  }
+  // override values with the values returned thereafter for subscribers
+  std::vector<OverrideChange> changes;
+  if (m_notifier.hasSubscribers())
+  {
+    m_overrides.forEach([this, &changes](const char* section, const char* key, const spConfigValue &cv) {
+      spConfigValue *pNew = findStoredValue(spConfigKey(section, key));
+      if (!pNew || (strcmp(pNew->c_str(), cv.c_str()) != 0))
       {
-        newPath[i] = '\\';
+        changes.push_back(OverrideChange{ section, key, cv, pNew ? *pNew : spConfigValue(), true, pNew != nullptr });
       }
-    }
-#endif
+      return true;
+    });
+  }
+  m_overrides.reset();
+  m_hasOverrides = false;
+  nextGeneration();
+  lock.unlock();
 
-    // append trailing separator, Windows or Linux style
-    if (newPath.back() != SPCONFIG_FILEPATH_SEPARATOR)
+  notifyOverrideChanges(changes);
+}
+
+/**
+ * @brief return the generation number, which is increased with every change of any value, 
+ *        e.g. to find out cheaply whether values read before may have changed
+ * 
+ * @return uint64_t  generation number
+ */
+uint64_t spConfigBase::getGeneration()
+{
+  return m_generation.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief compile override, stored and default values into a read-only table with a minimal perfect hash,
+ *        which the getters use from then on to find any value with a single probe
+ *        while frozen, setValue(), removeValue(), removeSection() and the override and defaults functions 
+ *        are rejected, while read(), reset() and reload() build a new table once for all values loaded
+ * 
+ * @return true / false  for success
+ */
+bool spConfigBase::freeze()
+{
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  std::shared_ptr<spConfigFrozen> pFrozen = buildFrozen(m_pStore.get(), m_pDefaults.get());
+  if (!pFrozen)
+  {
+    return false;
+  }
+  m_pFrozen = pFrozen;
+  return true;
+}
+
+/**
+ * @brief stop using the read-only table created by freeze(), so values can be changed again
+ * 
+ */
+void spConfigBase::thaw()
+{
+  std::shared_ptr<spConfigFrozen> pFrozen;
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  pFrozen.swap(m_pFrozen);
+}
+
+/**
+ * @brief returns whether the getters use the read-only table created by freeze()
+ * 
+ * @return true / false 
+ */
+bool spConfigBase::frozen()
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  return (m_pFrozen != nullptr);
+}
+
+/**
+ * @brief returns whether the config object holds any changed and not yet saved values
+ * 
+ * @return true / false 
+ */
+bool spConfigBase::changed()
+{
+  return m_hasChanged;
+}
+
+/**
+ * @brief reset configuration to either 'filename-default.ini' or to an empty list, if no default file exists
+ *        the defaults are kept in their own layer, so the saved 'filename.ini' will be empty
+ * 
+ * @return true / false  for values replaced, false when keeping the current ones, e.g. when exceeding memory limits
+ */
+bool spConfigBase::reset()
+{
+  if (!canUseFS())
+  {
+    return false;
+  }
+  spConfigTraceScope trace(m_tracer, "reset");
+  ValueMap oldValues;
+  collectValues(oldValues);
+
+  {
+    std::lock_guard<std::mutex> fileLock(m_fileMutex);
+    // read defaults and replace all at once, so readers never see an empty store
+    m_parseFailed = false;
+    std::shared_ptr<spConfigDefaults> pNewDefaults = stageDefaults();
+    std::shared_ptr<spConfigStore> pNewStore = stageStore(pNewDefaults.get());
+    if (!pNewStore)
+    {
+      return false;
+    }
+    if (m_parseFailed)
+    {
+      spLOGF_E("spConfigBase::reset() keeping current values, as %s exceeds memory limits", m_filenameUsed.c_str());
+      return false;
+    }
+    if (!swapGeneration(pNewStore, pNewDefaults))
+    {
+      return false;
+    }
+    m_hasChanged = true; // force save
+    writeIniFile();
+    m_hasChanged = false;
+  }
+  notifyDifferences(oldValues);
+  return true;
+}
+
+
+/**
+ * @brief try to read configuration data from 'config-default.ini' file and 'config.ini' file
+ * 
+ * @return true / false  for values replaced, false when keeping the current ones, e.g. when exceeding memory limits
+ */
+bool spConfigBase::read(){
+
+  if (!canUseFS())
+  {
+    return false;
+  }
+  spConfigTraceScope trace(m_tracer, "read");
+
+  ValueMap oldValues;
+  collectValues(oldValues);
+
+  {
+    std::lock_guard<std::mutex> fileLock(m_fileMutex);
+    // parse into staging stores without blocking readers and replace all at once
+    m_parseFailed = false;
+    std::shared_ptr<spConfigDefaults> pNewDefaults = stageDefaults();
+    std::shared_ptr<spConfigStore> pNewStore = stageStore(pNewDefaults.get());
+    if (!pNewStore)
+    {
+      return false;
+    }
+    bool fileRead = !m_parseFailed && parseIniFile(m_slotMode ? selectSlot() : m_configFilename, *pNewStore);
+    if (m_parseFailed)
+    {
+      spLOGF_E("spConfigBase::read() keeping current values, as %s exceeds memory limits", m_filenameUsed.c_str());
+      return false;
+    }
+    if (!swapGeneration(pNewStore, pNewDefaults))
+    {
+      return false;
+    }
+    if (!fileRead)
+    {
+      m_hasChanged = true; // force save
+      writeIniFile();
+    }
+    m_hasChanged = false;
+  }
+  notifyDifferences(oldValues);
+  return true;
+}
+
+/**
+ * @brief save configuration values to the 'config.ini' file when values have previously been changed 
+ *        only values differing from those in the defaults layer are written
+ * 
+ */
+void spConfigBase::save()
+{
+  if (!m_hasChanged || !canUseFS())
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> fileLock(m_fileMutex);
+  writeIniFile();
+}
+
+/**
+ * @brief re-read the configuration files into new stores, which replace the current ones at once, 
+ *        when any value differs, while getters keep returning the current values until then
+ *        values changed or removed by setValue(), removeValue() or removeSection() and not yet saved 
+ *        are kept as they are, so reload() never reverts unsaved changes
+ * 
+ * @return true / false  for any values changed
+ */
+bool spConfigBase::reload()
+{
+  if (!canUseFS())
+  {
+    return false;
+  }
+  spConfigTraceScope trace(m_tracer, "reload");
+
+  ValueMap oldValues;
+  size_t changes = 0;
+  {
+    std::lock_guard<std::mutex> fileLock(m_fileMutex);
+
+    // parse into staging stores without blocking readers
+    m_parseFailed = false;
+    std::shared_ptr<spConfigDefaults> pNewDefaults = stageDefaults();
+    std::shared_ptr<spConfigStore> pNewStore = stageStore(pNewDefaults.get());
+    if (!pNewStore || m_parseFailed || !parseIniFile(m_slotMode ? selectSlot() : m_configFilename, *pNewStore) || m_parseFailed)
+    {
+      if (m_parseFailed)
+      {
+        spLOGF_E("spConfigBase::reload() keeping current values, as %s exceeds memory limits", m_filenameUsed.c_str());
+      }
+      else
+      {
+        spLOGF_D("spConfigBase::reload() keeping current values, as %s could not be read", makeFilename(m_configFilename).c_str());
+      }
+      return false;
+    }
+
+    collectValues(oldValues);
+
+    // replace store and defaults as a whole, when they differ from the current ones
+    spConfigTraceScope mergeTrace(m_tracer, "merge");
+    std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+    // keep values changed or removed since the last save
+    for (const std::pair<std::string, std::string> &dirty : m_dirtyKeys)
+    {
+      spConfigKey dirtyKey(dirty.first.c_str(), dirty.first.length(), dirty.second.c_str(), dirty.second.length());
+      spConfigValue *pCurrent = m_pStore->find(dirtyKey);
+      if (!pCurrent)
+      {
+        pNewStore->remove(dirtyKey);
+      }
+      else if (!pNewStore->set(dirtyKey, *pCurrent))
+      {
+        spLOGF_E("spConfigBase::reload() keeping current values, as unsaved changes would exceed the memory budget");
+        return false;
+      }
+    }
+    size_t defaultChanges = pNewDefaults ? countDifferences(m_pDefaults->m_store, pNewDefaults->m_store) : 0;
+    changes = defaultChanges + countDifferences(*m_pStore, *pNewStore);
+    if ((changes > 0) && m_pFrozen && !swapFrozen(pNewStore.get(), (defaultChanges > 0) ? pNewDefaults.get() : m_pDefaults.get()))
+    {
+      return false;
+    }
+    if (changes > 0)
+    {
+      // replaced store and defaults are released with the staged pointers after unlocking
+      pNewStore.swap(m_pStore);
+      if (defaultChanges > 0)
+      {
+        pNewDefaults.swap(m_pDefaults);
+      }
+      m_pStore->setMemoryLimit(storeBudget(m_pDefaults.get()));
+      nextGeneration();
+    }
+    mergeTrace.values = changes;
+  }
+
+  if (changes > 0)
+  {
+    spLOGF_D("spConfigBase::reload() applied %d changes", (int)changes);
+    notifyDifferences(oldValues);
+  }
+  return (changes > 0);
+}
+
+
+/**
+ * @brief set watch mode to reload() automatically after changes of the configuration files or, in slot mode, 
+ *        of the slot files by others and return previous mode, changes made by save() are ignored and 
+ *        reload() keeps unsaved changes, files are not watched while a storage is set by setStorage()
+ * 
+ * @param watch true or false
+ * @return true or false
+ */
+bool spConfigBase::setWatch(bool watch)
+{
+  bool oldWatch = m_watch.exchange(watch);
+  if (watch && !oldWatch)
+  {
+    // ensure we have a watch task
+    ensureWatchTask();
+  }
+  return oldWatch;
+}
+
+/**
+ * @brief return status of watch mode
+ * 
+ * @return true / false 
+ */
+bool spConfigBase::getWatch()
+{
+  return m_watch;
+}
+
+/**
+ * @brief set slot mode and return previous mode, in slot mode save() alternates between two slot files 
+ *        and read() uses the one with the newest valid content
+ * 
+ * @param slotMode true or false
+ * @return true or false
+ */
+bool spConfigBase::setSlotMode(bool slotMode)
+{
+  std::lock_guard<std::mutex> fileLock(m_fileMutex);
+  bool oldSlotMode = m_slotMode;
+  m_slotMode = slotMode;
+  m_activeSlot = -1;
+  return oldSlotMode;
+}
+
+/**
+ * @brief returns whether save() writes to slot files
+ * 
+ * @return true or false
+ */
+bool spConfigBase::getSlotMode()
+{
+  return m_slotMode;
+}
+
+/**
+ * @brief set autosave mode and return previous mode
+ * 
+ * @param autosave true or false
+ * @return true or false
+ */
+bool spConfigBase::setAutosave(bool autosave)
+{
+  bool oldAutosave = m_autosave;
+  if (m_autosave != autosave)
+  {
+    m_autosave = autosave;
+    if (oldAutosave)
+    {
+      // ensure we have no unsaved stuff
+      save();
+    }
+    else 
+    {
+      // ensure we have a looptask
+      ensureLoopTask();
+    }
+  }
+  return oldAutosave;
+}
+
+
+/**
+ * @brief return status of autosave
+ * 
+ * @return true / false 
+ */
+bool spConfigBase::getAutosave()
+{
+  return m_autosave;
+}
+
+
+/**
+ * @brief subscribe to changes made by setValue(), read(), reset() or override values, the callback is called
+ *        with the old and new values, whenever the value returned by the getters changes
+ * 
+ * @param section   name of section or nullptr / "" for changes in all sections
+ * @param key       name of key or nullptr / "" for changes of all keys in section
+ * @param callback  function to call
+ * @return uint32_t  subscription ID to be used with unsubscribe() or 0 for failure
+ */
+uint32_t spConfigBase::subscribe(const char* section, const char* key, spConfigChangeCallback callback)
+{
+  return m_notifier.subscribe(section, key, callback);
+}
+
+/**
+ * @brief remove a subscription
+ * 
+ * @param subscriptionId  ID as returned by subscribe()
+ * @return true / false  for subscription found and removed
+ */
+bool spConfigBase::unsubscribe(uint32_t subscriptionId)
+{
+  return m_notifier.unsubscribe(subscriptionId);
+}
+
+/**
+ * @brief set whether subscribers are called inline or from a notification task and return previous mode
+ * 
+ * @param async true or false
+ * @return true or false
+ */
+bool spConfigBase::setNotifyAsync(bool async)
+{
+  bool oldAsync = m_notifier.getAsync();
+  if (oldAsync != async)
+  {
+    m_notifier.setAsync(async);
+    if (oldAsync)
+    {
+      // ensure queued changes are not lost
+      dispatchChanges();
+    }
+    else
+    {
+      // ensure we have a notification task
+      ensureNotifyTask();
+    }
+  }
+  return oldAsync;
+}
+
+/**
+ * @brief return whether subscribers are called from a notification task
+ * 
+ * @return true / false 
+ */
+bool spConfigBase::getNotifyAsync()
+{
+  return m_notifier.getAsync();
+}
+
+/**
+ * @brief set name of the configuration file, the standard is 'config'
+ * 
+ * @param newName 
+ */
+void spConfigBase::setConfigFilename(std::string newName)
+{
+  if (newName.length() > 0)
+  {
+    m_configFilename = newName;
+  }
+}
+
+/**
+ * @brief return the name of the configuration file
+ * 
+ * @return std::string 
+ */
+std::string spConfigBase::getConfigFilename()
+{
+  return m_configFilename;
+}
+
+/**
+ * @brief set name of the default configuration file, the standard is 'config-default'
+ * 
+ * @param newName 
+ */
+void spConfigBase::setConfigDefaultFilename(std::string newName)
+{
+  if (newName.length() > 0)
+  {
+    m_configDefaultFilename = newName;
+  }
+}
+
+/**
+ * @brief return the name of the default configuration file
+ * 
+ * @return std::string 
+ */
+std::string spConfigBase::getConfigDefaultFilename()
+{
+  return m_configDefaultFilename;
+}
+
+/**
+ * @brief set extension of the configuration file, the standard is 'ini'
+ * 
+ * @param newExtension 
+ */
+void spConfigBase::setConfigFileExtension(std::string newExtension)
+{
+  if (newExtension.length() > 0)
+  {
+    m_configFileExtension = newExtension;
+  }
+}
+
+/**
+ * @brief return the extension of the configuration file
+ * 
+ * @return std::string 
+ */
+std::string spConfigBase::getConfigFileExtension()
+{
+  return m_configFileExtension;
+}
+
+
+/**
+ * @brief set the path of the configuration file, the standard is an empty string, meaning 
+ *        the files are located in the application directory
+ * 
+ * @param newPath 
+ */
+void spConfigBase::setConfigFilePath(std::string newPath)
+{
+  size_t len = newPath.length();
+  if (len > 0)
+  {
+
+#ifdef SPCONFIG_WINDOWS_OS
+    // set preferred separator on Windows
+    for (size_t i = 0; i < len; i++)
+    {
+      if (newPath[i] == '/')
+      {
+        newPath[i] = '\\';
+      }
+    }
+#endif
+
+    // append trailing separator, Windows or Linux style
+    if (newPath.back() != SPCONFIG_FILEPATH_SEPARATOR)
+    {
+      newPath += SPCONFIG_FILEPATH_SEPARATOR;
+    }
+  }
+  m_configFilePath = newPath;
+}
+
+/**
+ * @brief return the path of the configuration file
+ * 
+ * @return std::string 
+ */
+std::string spConfigBase::getConfigFilePath()
+{
+  return m_configFilePath;
+}
+
+
+/*    PRIVATE    PRIVATE    PRIVATE    PRIVATE
+
+      xxxxxxx   xxxxxxx      xx     xx    xx     xx     xxxxxxxx  xxxxxxxx
+      xx    xx  xx    xx     xx     xx    xx    xxxx       xx     xx      
+      xx    xx  xx    xx     xx     xx    xx   xx  xx      xx     xx      
+      xxxxxxx   xxxxxxx      xx      xx  xx   xx    xx     xx     xxxxxxx    
+      xx        xx    xx     xx      xx  xx   xxxxxxxx     xx     xx    
+      xx        xx    xx     xx       xxxx    xx    xx     xx     xx      
+      xx        xx    xx     xx        xx     xx    xx     xx     xxxxxxxx
+     
+
+      PRIVATE    PRIVATE    PRIVATE    PRIVATE    */
+
+
+
+
+/**
+ * @brief set changed to true and call onSetChanged()
+ * 
+ */
+void spConfigBase::setChanged()
+{
+  m_hasChanged = true;
+  onSetChanged();
+}
+
+/**
+ * @brief find the value for section and key, looking at the override values first, then 
+        at the stored values and finally falling through to the defaults layer, unless frozen
+ * 
+ * @param key  section and key with hash
+ * @return spConfigValue*  pointer to value or nullptr if not found in any layer
+ */
+spConfigValue* spConfigBase::findValue(const spConfigKey &key)
+{
+  SPCONFIG_METRIC(m_metrics.lookups.add());
+  if (m_profiling.load(std::memory_order_relaxed))
+  {
+    m_profile.count(key.hash());
+  }
+  spConfigValue *cv = nullptr;
+  if (m_pFrozen)
+  {
+    cv = m_pFrozen->find(key);
+  }
+  else
+  {
+    if (m_hasOverrides)
+    {
+      cv = m_overrides.find(key);
+    }
+    if (!cv)
+    {
+      cv = findStoredValue(key);
+    }
+  }
+#ifndef SPCONFIG_NO_METRICS
+  if (!cv)
+  {
+    m_metrics.misses.add();
+  }
+#endif
+  return cv;
+}
+
+/**
+ * @brief find the value to be saved for section and key, i.e. the stored value or the default value
+ *        if nothing stored, while ignoring any override values
+ * 
+ * @param key  section and key with hash
+ * @return spConfigValue*  pointer to value or nullptr if not found
+ */
+spConfigValue* spConfigBase::findStoredValue(const spConfigKey &key)
+{
+  spConfigValue *cv = m_pStore->find(key);
+  if (!cv)
+  {
+    cv = m_pDefaults->find(key);
+  }
+  return cv;
+}
+
+/**
+ * @brief store a new value in the store, i.e. the layer on top of the defaults
+ *        and mark the config as changed
+ * 
+ * @param key  section and key with hash
+ * @param value 
+ * @param lock  exclusive lock held by caller, released before notifying subscribers
+ * @return true / false  for value stored
+ */
+bool spConfigBase::storeValue(const spConfigKey &key, const spConfigValue &value, std::unique_lock<std::shared_mutex> &lock)
+{
+  if (rejectFrozen("setValue"))
+  {
+    return false;
+  }
+  // keep old value for subscribers, unless hidden by an override value
+  bool notify = m_notifier.hasSubscribers() && !(m_hasOverrides && m_overrides.find(key));
+  spConfigValue oldValue;
+  bool hasOldValue = false;
+  if (notify)
+  {
+    spConfigValue *pOld = findStoredValue(key);
+    if (pOld)
+    {
+      oldValue = *pOld;
+      hasOldValue = true;
+    }
+  }
+
+  if (!m_pStore->set(key, value))
+  {
+    return false;
+  }
+  markDirty(key);
+  compactStore();
+  nextGeneration();
+  lock.unlock();
+  SPCONFIG_METRIC(m_metrics.stores.add());
+  setChanged();
+
+  if (notify)
+  {
+    notifyChange(key, hasOldValue ? &oldValue : nullptr, &value);
+  }
+  return true;
+}
+
+/**
+ * @brief replace a store using an arena by a copy, once more of the arena is taken by removed or outgrown 
+ *        values than by the values stored, so changes do not grow the arena without limit until the next 
+ *        read(), reset() or reload(), called with exclusive lock held
+ * 
+ */
+void spConfigBase::compactStore()
+{
+  size_t waste = m_pStore->arenaWaste();
+  if ((waste < SPCONFIG_ARENA_COMPACT_MIN) || (waste < m_pStore->memoryUsed()))
+  {
+    return;
+  }
+  std::shared_ptr<spConfigStore> pStore = std::make_shared<spConfigStore>(m_pStore->getNamePool(), m_pMemoryResource);
+  bool copied = true;
+  m_pStore->forEach([&pStore, &copied](const char* section, const char* key, const spConfigValue &cv) {
+    copied = (pStore->set(spConfigKey(section, key), cv) != nullptr);
+    return copied;
+  });
+  if (!copied)
+  {
+    return;
+  }
+  pStore->setMemoryLimit(m_pStore->getMemoryLimit());
+  m_pStore = pStore;
+}
+
+/**
+ * @brief increase the generation number after a change, called with exclusive lock held
+ * 
+ */
+void spConfigBase::nextGeneration()
+{
+  m_generation.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief report a change rejected, as values are frozen, called with lock held
+ * 
+ * @param function  name of function rejected
+ * @return true / false  for rejected
+ */
+bool spConfigBase::rejectFrozen(const char* function)
+{
+  if (!m_pFrozen)
+  {
+    return false;
+  }
+  spLOGF_E("spConfigBase::%s() rejected, as values are frozen, call thaw() first", function);
+  return true;
+}
+
+/**
+ * @brief build a read-only table from the override values and the store and defaults given, called with lock held
+ * 
+ * @param pStore  stored values
+ * @param pDefaults  defaults layer
+ * @return std::shared_ptr<spConfigFrozen>  table or nullptr for failure
+ */
+std::shared_ptr<spConfigFrozen> spConfigBase::buildFrozen(const spConfigStore* pStore, const spConfigDefaults* pDefaults)
+{
+  std::shared_ptr<spConfigFrozen> pFrozen = std::make_shared<spConfigFrozen>();
+  if (!pFrozen->build({ m_hasOverrides ? &m_overrides : nullptr, pStore, &pDefaults->m_store }))
+  {
+    return nullptr;
+  }
+  return pFrozen;
+}
+
+/**
+ * @brief create an empty defaults layer using the name pool and memory of the config object, called with lock held
+ * 
+ * @return std::shared_ptr<spConfigDefaults>  new defaults layer or nullptr when fixed memory is exhausted
+ */
+std::shared_ptr<spConfigDefaults> spConfigBase::newDefaults()
+{
+  if (m_pFixedMemory)
+  {
+    std::lock_guard<spConfigFixedMemory> memoryLock(*m_pFixedMemory);
+    size_t sizes[] = { sizeof(spConfigDefaults) + SPCONFIG_SHARED_OVERHEAD, spConfigStore::indexBytes(m_fixedCapacity) };
+    if (!m_pFixedMemory->fits(sizes, 2))
+    {
+      spLOG_E("spConfigBase::newDefaults() failed, as fixed memory is exhausted");
+      return nullptr;
+    }
+    return std::allocate_shared<spConfigDefaults>(std::pmr::polymorphic_allocator<spConfigDefaults>(m_pFixedMemory), m_pNamePool, m_pFixedMemory, m_fixedCapacity);
+  }
+  return std::make_shared<spConfigDefaults>(m_pNamePool, m_pMemoryResource);
+}
+
+/**
+ * @brief read the default configuration file into a new defaults layer, unless a shared one is used
+ *        a new layer is created every time, as the previous one may have been shared already
+ *        with a default table, the file is optional and its values replace those of the table
+ *        called with file access guarded
+ * 
+ * @return std::shared_ptr<spConfigDefaults>  new defaults layer or nullptr to keep the current one, when using shared defaults or out of fixed memory
+ */
+std::shared_ptr<spConfigDefaults> spConfigBase::stageDefaults()
+{
+  if (m_sharedDefaults)
+  {
+    return nullptr;
+  }
+  spConfigTraceScope trace(m_tracer, "defaults");
+  std::shared_ptr<spConfigDefaults> pDefaults;
+  {
+    std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+    pDefaults = newDefaults();
+    if (!pDefaults)
+    {
+      m_parseFailed = true;
+      return nullptr;
+    }
+    pDefaults->m_store.setMemoryLimit(m_memoryBudget);
+    if (!pDefaults->addTable(m_pDefaultTable, m_defaultTableCount))
+    {
+      m_parseFailed = true;
+      return nullptr;
+    }
+  }
+  parseIniFile(m_configDefaultFilename, pDefaults->m_store);
+  return pDefaults;
+}
+
+/**
+ * @brief create an empty store to load values into, using the name pool and memory of the config object
+ * 
+ * @return std::shared_ptr<spConfigStore>  new store or nullptr when fixed memory is exhausted
+ */
+std::shared_ptr<spConfigStore> spConfigBase::stageStore(const spConfigDefaults* pNewDefaults)
+{
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  std::shared_ptr<spConfigStore> pStore;
+  if (m_pFixedMemory)
+  {
+    std::lock_guard<spConfigFixedMemory> memoryLock(*m_pFixedMemory);
+    size_t sizes[] = { sizeof(spConfigStore) + SPCONFIG_SHARED_OVERHEAD, spConfigStore::indexBytes(m_fixedCapacity) };
+    if (!m_pFixedMemory->fits(sizes, 2))
+    {
+      spLOG_E("spConfigBase::stageStore() failed, as fixed memory is exhausted");
+      return nullptr;
+    }
+    pStore = std::allocate_shared<spConfigStore>(std::pmr::polymorphic_allocator<spConfigStore>(m_pFixedMemory), m_pNamePool, m_pFixedMemory, m_fixedCapacity);
+  }
+  else
+  {
+    pStore = std::make_shared<spConfigStore>(m_pNamePool, m_pMemoryResource);
+  }
+  // budget left by the defaults, which will be used with the store
+  pStore->setMemoryLimit(storeBudget(pNewDefaults ? pNewDefaults : m_pDefaults.get()));
+  return pStore;
+}
+
+/**
+ * @brief return the memory limit of a store for stored values with the budget and the defaults given, 
+ *        called with stores guarded
+ * 
+ * @param pDefaults  defaults used with the store
+ * @return size_t  bytes left by the defaults or 0 for no budget
+ */
+size_t spConfigBase::storeBudget(const spConfigDefaults* pDefaults)
+{
+  size_t budget = m_memoryBudget;
+  if (budget == 0)
+  {
+    return 0;
+  }
+  size_t used = pDefaults->m_store.memoryUsed();
+  // at least 1 byte, as 0 would remove the limit
+  return (budget > used) ? budget - used : 1;
+}
+
+/**
+ * @brief replace store and defaults layer with fully loaded new ones by exchanging pointers,
+ *        so readers never see an empty or partly loaded store, the replaced ones are released 
+ *        after unlocking
+ * 
+ * @param pNewStore  new store
+ * @param pNewDefaults  new defaults layer or nullptr to keep the current one
+ * @return true / false  for success, false when frozen and the table could not be built
+ */
+bool spConfigBase::swapGeneration(std::shared_ptr<spConfigStore> pNewStore, std::shared_ptr<spConfigDefaults> pNewDefaults)
+{
+  spConfigTraceScope trace(m_tracer, "swap");
+  {
+    std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+    if (m_pFrozen && !swapFrozen(pNewStore.get(), pNewDefaults ? pNewDefaults.get() : m_pDefaults.get()))
+    {
+      return false;
+    }
+    // replaced store and defaults are released with the parameters after unlocking
+    pNewStore.swap(m_pStore);
+    m_dirtyKeys.clear();
+    if (pNewDefaults)
+    {
+      pNewDefaults.swap(m_pDefaults);
+    }
+    nextGeneration();
+  }
+  // reads are counted since the values were loaded
+  m_profile.clear();
+  return true;
+}
+
+/**
+ * @brief remember a key changed or removed since the last save, called with exclusive lock held
+ * 
+ * @param key  section and key with hash
+ */
+void spConfigBase::markDirty(const spConfigKey &key)
+{
+  m_dirtyKeys.emplace(std::string(key.section(), key.sectionLength()), std::string(key.key(), key.keyLength()));
+}
+
+/**
+ * @brief replace the read-only table by one built for a new store and defaults, called with exclusive lock held
+ * 
+ * @param pNewStore  new store
+ * @param pNewDefaults  new defaults layer
+ * @return true / false  for success, otherwise the current table is kept
+ */
+bool spConfigBase::swapFrozen(const spConfigStore* pNewStore, const spConfigDefaults* pNewDefaults)
+{
+  std::shared_ptr<spConfigFrozen> pFrozen = buildFrozen(pNewStore, pNewDefaults);
+  if (!pFrozen)
+  {
+    spLOG_E("spConfigBase::swapFrozen() keeping current values, as no frozen table could be built for the values loaded");
+    return false;
+  }
+  m_pFrozen = pFrozen;
+  return true;
+}
+
+/**
+ * @brief collect the values returned by the getters (ignoring override values, which are not affected
+ *        by read() and reset()) in order to find the differences after a change of the whole config
+ *        only done when there are subscribers
+ * 
+ * @param values  map to hold the values by section and key
+ */
+void spConfigBase::collectValues(ValueMap &values)
+{
+  if (!m_notifier.hasSubscribers())
+  {
+    return;
+  }
+  std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+  // defaults first, so stored values replace them
+  m_pDefaults->m_store.forEach([&values](const char* section, const char* key, const spConfigValue &cv) {
+    values[std::make_pair(std::string(section), std::string(key))] = cv.c_str() ? cv.c_str() : "";
+    return true;
+  });
+  m_pStore->forEach([&values](const char* section, const char* key, const spConfigValue &cv) {
+    values[std::make_pair(std::string(section), std::string(key))] = cv.c_str() ? cv.c_str() : "";
+    return true;
+  });
+}
+
+/**
+ * @brief collect all values in overrides, stored values and defaults with their reads, ordered by section and key
+ * 
+ * @param keys  vector to hold the values
+ */
+void spConfigBase::collectKeyReads(std::vector<spConfigKeyReads> &keys)
+{
+  std::map<std::pair<std::string, std::string>, uint64_t> reads;
+  auto collect = [this, &reads](const char* section, const char* key, const spConfigValue &) {
+    reads[std::make_pair(std::string(section), std::string(key))] = m_profile.reads(spConfigKey(section, key).hash());
+    return true;
+  };
+  {
+    std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+    if (m_hasOverrides)
+    {
+      m_overrides.forEach(collect);
+    }
+    m_pStore->forEach(collect);
+    m_pDefaults->m_store.forEach(collect);
+  }
+  keys.reserve(keys.size() + reads.size());
+  for (auto &entry : reads)
+  {
+    spConfigKeyReads keyReads;
+    keyReads.section = entry.first.first;
+    keyReads.key = entry.first.second;
+    keyReads.reads = entry.second;
+    keys.push_back(keyReads);
+  }
+}
+
+/**
+ * @brief notify subscribers about all values differing from those collected before
+ * 
+ * @param oldValues  map with values by section and key as collected by collectValues()
+ */
+void spConfigBase::notifyDifferences(const ValueMap &oldValues)
+{
+  if (!m_notifier.hasSubscribers())
+  {
+    return;
+  }
+  spConfigTraceScope trace(m_tracer, "notify");
+  ValueMap newValues;
+  collectValues(newValues);
+
+  // both maps are sorted by section and key, so walk them side by side
+  auto oldIt = oldValues.begin();
+  auto newIt = newValues.begin();
+  while ((oldIt != oldValues.end()) || (newIt != newValues.end()))
+  {
+    if ((newIt == newValues.end()) || ((oldIt != oldValues.end()) && (oldIt->first < newIt->first)))
+    {
+      spConfigValue oldValue(oldIt->second);
+      notifyChange(spConfigKey(oldIt->first.first.c_str(), oldIt->first.first.length(), oldIt->first.second.c_str(), oldIt->first.second.length()), &oldValue, nullptr);
+      oldIt++;
+    }
+    else if ((oldIt == oldValues.end()) || (newIt->first < oldIt->first))
+    {
+      spConfigValue newValue(newIt->second);
+      notifyChange(spConfigKey(newIt->first.first.c_str(), newIt->first.first.length(), newIt->first.second.c_str(), newIt->first.second.length()), nullptr, &newValue);
+      newIt++;
+    }
+    else
+    {
+      if (oldIt->second != newIt->second)
+      {
+        spConfigValue oldValue(oldIt->second);
+        spConfigValue newValue(newIt->second);
+        notifyChange(spConfigKey(newIt->first.first.c_str(), newIt->first.first.length(), newIt->first.second.c_str(), newIt->first.second.length()), &oldValue, &newValue);
+      }
+      oldIt++;
+      newIt++;
+    }
+  }
+}
+
+/**
+ * @brief pass a change to the notifier, unless hidden by an override value
+ * 
+ * @param key  section and key with hash
+ * @param pOldValue  value before change or nullptr
+ * @param pNewValue  value after change or nullptr
+ */
+void spConfigBase::notifyChange(const spConfigKey &key, const spConfigValue* pOldValue, const spConfigValue* pNewValue)
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+    if (m_hasOverrides && m_overrides.find(key))
+    {
+      return;
+    }
+  }
+  if (m_notifier.notify(key.section(), key.key(), pOldValue, pNewValue))
+  {
+    onChangeQueued();
+  }
+}
+
+/**
+ * @brief set override values all at once, with a single new generation, and notify subscribers about 
+ *        each value returned by the getters, which changes
+ * 
+ * @param overrides  values by section and key
+ */
+void spConfigBase::applyOverrides(const ValueMap &overrides)
+{
+  if (overrides.empty())
+  {
+    return;
+  }
+  std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+  if (rejectFrozen("setOverride"))
+  {
+    return;
+  }
+  bool notify = m_notifier.hasSubscribers();
+  std::vector<OverrideChange> changes;
+  bool added = false;
+  for (const ValueMap::value_type &entry : overrides)
+  {
+    const std::string &section = entry.first.first;
+    const std::string &key = entry.first.second;
+    spConfigKey overrideKey(section.c_str(), section.length(), key.c_str(), key.length());
+    spConfigValue *pOld = m_hasOverrides ? m_overrides.find(overrideKey) : nullptr;
+    if (!pOld)
+    {
+      pOld = findStoredValue(overrideKey);
+    }
+    bool changed = !(pOld && (strcmp(pOld->c_str(), entry.second.c_str()) == 0));
+    spConfigValue oldValue;
+    if (notify && changed && pOld)
+    {
+      oldValue = *pOld;
+    }
+    if (!m_overrides.set(overrideKey, entry.second.c_str()))
+    {
+      continue;
+    }
+    added = true;
+    if (notify && changed)
+    {
+      changes.push_back(OverrideChange{ section, key, oldValue, entry.second.c_str(), pOld != nullptr, true });
+    }
+  }
+  if (!added)
+  {
+    return;
+  }
+  m_hasOverrides = true;
+  nextGeneration();
+  lock.unlock();
+
+  notifyOverrideChanges(changes);
+}
+
+/**
+ * @brief pass changes of override values to the notifier, which are not hidden, as override values 
+ *        take precedence
+ * 
+ * @param changes  keys with old and new values
+ */
+void spConfigBase::notifyOverrideChanges(const std::vector<OverrideChange> &changes)
+{
+  bool queued = false;
+  for (const OverrideChange &change : changes)
+  {
+    queued = m_notifier.notify(change.section.c_str(), change.key.c_str(), change.hasOldValue ? &change.oldValue : nullptr, 
+                               change.hasNewValue ? &change.newValue : nullptr) || queued;
+  }
+  if (queued)
+  {
+    onChangeQueued();
+  }
+}
+
+/**
+ * @brief count the sections and keys with values differing between two stores
+ * 
+ * @param store1 
+ * @param store2 
+ * @return size_t  number of keys found in only one store or with different values, 0 for same values
+ */
+size_t spConfigBase::countDifferences(const spConfigStore &store1, const spConfigStore &store2)
+{
+  size_t differences = 0;
+  size_t common = 0;
+  store1.forEach([&store2, &differences, &common](const char* section, const char* key, const spConfigValue &cv) {
+    spConfigValue *cv2 = store2.find(spConfigKey(section, key));
+    if (!cv2)
+    {
+      differences++;
+      return true;
+    }
+    common++;
+    if (strcmp(cv2->c_str() ? cv2->c_str() : "", cv.c_str() ? cv.c_str() : "") != 0)
+    {
+      differences++;
+    }
+    return true;
+  });
+  // keys of store2 not in store1
+  return differences + store2.count() - common;
+}
+
+/**
+ * @brief combine path, name and extension to the filename used for file access
+ * 
+ * @param name  name of file without path and extension
+ * @return std::string  filename
+ */
+std::string spConfigBase::makeFilename(const std::string &name)
+{
+  std::string ret = m_configFilePath + name;
+  if (m_configFileExtension.length() > 0)
+  {
+    ret.append(".");
+    ret.append(m_configFileExtension);
+  }
+  return ret;
+}
+
+/**
+ * @brief write the stored values to the 'config.ini' file or in slot mode to the inactive slot file, called with file access guarded
+ * 
+ */
+void spConfigBase::writeIniFile()
+{
+  // slots not yet known, e.g. no read() since slot mode was set
+  if (m_slotMode && (m_activeSlot < 0))
+  {
+    selectSlot();
+  }
+
+  if (!ensureFileBuffer())
+  {
+    spLOG_E("spConfigBase::save() aborted");
+    return;
+  }
+
+  // start of file & buffer
+  m_fPos = 0;
+  m_fileBufUsed = 0;
+  m_saveFailed = false;
+  // keys changed since the last save, changed again if the save fails
+  std::set<std::pair<std::string, std::string>> savedKeys;
+  SPCONFIG_METRIC(auto startTime = std::chrono::steady_clock::now());
+
+  // with slots, the content is written to the slot not holding the newest valid content
+  bool slotMode = m_slotMode;
+  int slot = (m_activeSlot == 0) ? 1 : 0;
+  uint32_t seq = (m_activeSlot < 0) ? 1 : m_slotSeq + 1;
+
+  m_filenameUsed = makeFilename(slotMode ? slotName(slot) : m_configFilename);
+  spLOGF_D("saving %s", m_filenameUsed.c_str());
+  spConfigTraceScope trace(m_tracer, "save", m_filenameUsed.c_str());
+  if (!openOutput(m_filenameUsed))
+  {
+    m_saveFailed = true;
+  }
+
+  {
+    // values cannot change while being written
+    std::shared_lock<std::shared_mutex> lock(m_storeMutex);
+    m_hasChanged = false;
+    savedKeys.swap(m_dirtyKeys);
+
+    // callback, link non-static function to have access to non-static members, i.e. the spConfigBase object
+    auto callback = std::bind(&spConfigBase::saveIniEntryCB, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+    if (slotMode)
+    {
+      // first pass for the header only calculates length and CRC of the content
+      spConfigTraceScope measureTrace(m_tracer, "measure");
+      m_measureSave = true;
+      m_saveLen = 0;
+      m_saveCrc = 0;
+      m_lastSection = "";
+      m_pStore->forEach(callback);
+      m_measureSave = false;
+      m_fileBufUsed = snprintf(m_pFileBuf, SPCONFIG_FILEBUFSIZE, SPCONFIG_SLOT_HEADER, (unsigned int)seq, (unsigned int)m_saveLen, (unsigned int)m_saveCrc);
+      measureTrace.bytes = m_saveLen;
+    }
+
+    // init collection vars
+    m_lastSection = "";
+    m_pStore->forEach(callback);
+  }
+
+  // final write
+  flushFileBuffer();
+  {
+    spConfigTraceScope commitTrace(m_tracer, "commit");
+    if (!closeOutput(!m_saveFailed))
+    {
+      m_saveFailed = true;
+    }
+  }
+  trace.bytes = m_saveFailed ? 0 : m_fPos;
+#ifndef SPCONFIG_NO_METRICS
+  if (m_saveFailed)
+  {
+    m_metrics.saveFailures.fetch_add(1, std::memory_order_relaxed);
+  }
+  else
+  {
+    m_metrics.saveBytes.fetch_add(m_fPos, std::memory_order_relaxed);
+    m_metrics.saveTime.record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+  }
+#endif
+
+  if (m_saveFailed)
+  {
+    // with slots or a storage, the previous content is still intact
+    if (slotMode || m_pStorage)
+    {
+      spLOGF_E("spConfigBase::save() failed to write %s, keeping previous content", m_filenameUsed.c_str());
+    }
+    // values not saved are saved by the next save and kept by reload()
+    std::unique_lock<std::shared_mutex> lock(m_storeMutex);
+    m_hasChanged = true;
+    m_dirtyKeys.insert(savedKeys.begin(), savedKeys.end());
+  }
+  else if (slotMode)
+  {
+    m_activeSlot = slot;
+    m_slotSeq = seq;
+  }
+  // file as written, so watch mode can ignore the change
+  if (!m_saveFailed && !m_pStorage)
+  {
+    m_savedStamps[m_filenameUsed] = fileStamp(m_filenameUsed);
+  }
+
+  // release buffer
+  freeFileBuffer();
+}
+
+/**
+ * @brief allocate file buffer, or use the one of the config object with SPCONFIG_FIXED_MEMORY, and return success
+ * 
+ * @return true / false for success
+ */
+bool spConfigBase::ensureFileBuffer()
+{
+#ifdef SPCONFIG_FIXED_MEMORY
+  m_pFileBuf = m_fileBuf;
+#endif
+  if (m_pFileBuf == nullptr)
+  {
+    m_pFileBuf = (char*)malloc(SPCONFIG_FILEBUFSIZE);
+    if (m_pFileBuf == nullptr)
+    {
+      spLOGF_E("spConfigBase::ensureFileBuffer() could not allocate file buffer of size %d", SPCONFIG_FILEBUFSIZE);
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief release file buffer AND set to nullptr
+ * 
+ */
+void spConfigBase::freeFileBuffer()
+{
+#ifndef SPCONFIG_FIXED_MEMORY
+  free(m_pFileBuf);
+#endif
+  m_pFileBuf = nullptr;
+}
+
+/**
+ * @brief callback function for each entry in store
+ * 
+ * @param section  name of section
+ * @param key  name of key
+ * @param cv  configvalue in store
+ * @return true  for continue loop (as we want all values)
+ */
+bool spConfigBase::saveIniEntryCB(const char* section, const char* key, const spConfigValue &cv)
+{
+
+  if (m_pFileBuf == nullptr)
+  {
+    spLOG_E("spConfigBase::saveIniEntryCB() failed because no file buffer allocated");
+    return false;
+  }
+
+  // skip values not differing from the defaults layer
+  spConfigValue *dv = m_pDefaults->find(spConfigKey(section, key));
+  if (dv && dv->c_str() && cv.c_str() && (strcmp(dv->c_str(), cv.c_str()) == 0))
+  {
+    return true;
+  }
+
+  // entries of a section, which could not be read back, are not saved
+  if (strlen(section) + 2 > SPCONFIG_MAXLINELENGTH)
+  {
+    if (m_lastSection.compare(section) != 0)
+    {
+      m_lastSection = section;
+      spLOGF_E("spConfigBase::saveIniEntryCB: section %.40s... exceeds maximum line length of %i, its entries are not saved", section, SPCONFIG_MAXLINELENGTH);
+    }
+    return true;
+  }
+
+  // line string
+  std::string lineString = "";
+  char lineBuf[SPCONFIG_MAXLINELENGTH + 2]; // line with '\n'
+  size_t len;
+
+
+  // write new section
+  if (m_lastSection.compare(section) != 0)
+  {
+    if (m_lastSection.length() > 0)
+    {
+      lineString = "\n";
+    }
+    m_lastSection = section;
+    len = snprintf(lineBuf, sizeof(lineBuf), "[%s]\n", section);
+    lineString.append(lineBuf);
+  }
+
+  // write key = value, unless cut short, which would join it with the next line
+  const char* value = cv.c_str() ? cv.c_str() : "";
+  len = snprintf(lineBuf, sizeof(lineBuf), "%s=%s\n", key, value);
+  if (len > SPCONFIG_MAXLINELENGTH + 1)
+  {
+    spLOGF_E("spConfigBase::saveIniEntryCB: entry %s=%.40s... exceeds maximum line length of %i and is not saved", key, value, SPCONFIG_MAXLINELENGTH);
+  }
+  else
+  {
+    lineString.append(lineBuf);
+  }
+
+
+  len = lineString.length();
+  if (len > 0)
+  {
+    writeText(lineString.c_str(), len);
+  }
+  
+  return true;
+}
+
+/**
+ * @brief add text to the file buffer and write the buffer when full or, for the first pass of a save
+ *        to a slot, only add the text to length and CRC of the content
+ * 
+ * @param text 
+ * @param len  length of text
+ */
+void spConfigBase::writeText(const char* text, size_t len)
+{
+  if (m_measureSave)
+  {
+    m_saveLen += len;
+    m_saveCrc = crc32(m_saveCrc, text, len);
+    return;
+  }
+
+  // exceeding file buffer size?
+  if (m_fileBufUsed + len > SPCONFIG_FILEBUFSIZE)
+  {
+    flushFileBuffer();
+  }
+  
+  // copy line to buffer, in parts if longer than the buffer
+  while (len > 0)
+  {
+    size_t part = SPCONFIG_FILEBUFSIZE - m_fileBufUsed;
+    part = (len < part) ? len : part;
+    memcpy(m_pFileBuf + m_fileBufUsed, text, part);
+    m_fileBufUsed += part;
+    text += part;
+    len -= part;
+    if (len > 0)
     {
-      newPath += SPCONFIG_FILEPATH_SEPARATOR;
+      flushFileBuffer();
     }
   }
-  m_configFilePath = newPath;
 }
 
 /**
- * @brief return the path of the configuration file
+ * @brief write the file buffer at the current position in file and remember failures
  * 
- * @return std::string 
  */
-std::string spConfigBase::getConfigFilePath()
+void spConfigBase::flushFileBuffer()
 {
-  return m_configFilePath;
+  spConfigTraceScope trace(m_tracer, "flush");
+  trace.bytes = m_fileBufUsed;
+  if (!m_saveFailed && !writeOutput(m_fPos, m_pFileBuf, m_fileBufUsed))
+  {
+    m_saveFailed = true;
+  }
+  m_fPos += m_fileBufUsed;
+  m_fileBufUsed = 0;
 }
 
+/**
+ * @brief open a file for reading in the storage or, without storage, keep its name for readFile(), 
+ *        called with file access guarded
+ * 
+ * @param filename  name of file with path
+ * @return true / false  for success
+ */
+bool spConfigBase::openInput(const std::string &filename)
+{
+  m_ioFilename = filename;
+  if (m_pStorage)
+  {
+    return SPCONFIG_STORAGE_CALL(openRead, m_ioFilename.c_str(), m_file);
+  }
+  return true;
+}
 
-/*    PRIVATE    PRIVATE    PRIVATE    PRIVATE
-
-      xxxxxxx   xxxxxxx      xx     xx    xx     xx     xxxxxxxx  xxxxxxxx
-      xx    xx  xx    xx     xx     xx    xx    xxxx       xx     xx      
-      xx    xx  xx    xx     xx     xx    xx   xx  xx      xx     xx      
-      xxxxxxx   xxxxxxx      xx      xx  xx   xx    xx     xx     xxxxxxx    
-      xx        xx    xx     xx      xx  xx   xxxxxxxx     xx     xx    
-      xx        xx    xx     xx       xxxx    xx    xx     xx     xx      
-      xx        xx    xx     xx        xx     xx    xx     xx     xxxxxxxx
-     
-
-      PRIVATE    PRIVATE    PRIVATE    PRIVATE    */
-
-
-
+/**
+ * @brief return the whole content of the file opened for reading, if the storage provides it without copying
+ * 
+ * @param content  data and size of content, valid until closeInput()
+ * @return true / false  for content available, otherwise it must be read with readInput()
+ */
+bool spConfigBase::viewInput(spConfigSpan &content)
+{
+  return m_pStorage && SPCONFIG_STORAGE_CALL(view, m_file, content);
+}
 
 /**
- * @brief set changed to true and call onSetChanged()
+ * @brief read from the file opened for reading
  * 
+ * @param pos  position in file to start reading
+ * @param buf  buffer to hold content
+ * @param len  max number of bytes to read
+ * @return size_t  actual number of bytes read
  */
-void spConfigBase::setChanged()
+size_t spConfigBase::readInput(size_t pos, char* buf, size_t len)
 {
-  m_hasChanged = true;
-  onSetChanged();
+  spConfigTraceScope trace(m_tracer, "readFile");
+  if (m_pStorage)
+  {
+    trace.bytes = SPCONFIG_STORAGE_CALL(read, m_file, pos, buf, len);
+  }
+  else
+  {
+    trace.bytes = readFile(m_ioFilename, buf, pos, len);
+  }
+  return trace.bytes;
 }
 
 /**
- * @brief combine section and key to ID string
+ * @brief close the file opened for reading
  * 
- * @param section 
- * @param key 
- * @return std::string  ID used for store 
  */
-std::string spConfigBase::makeId(const char* section, const char* key)
+void spConfigBase::closeInput()
 {
-  std::string ret(section);
-  ret.append("#/#");
-  ret.append(key);
-  return ret;
+  if (m_pStorage)
+  {
+    SPCONFIG_STORAGE_CALL(close, m_file);
+  }
 }
 
 /**
- * @brief allocate file buffer and return success
+ * @brief open a file for writing, which with a storage is a temporary file replacing the file by closeOutput(),
+ *        called with file access guarded
  * 
- * @return true / false for success
+ * @param filename  name of file with path
+ * @return true / false  for success
  */
-bool spConfigBase::ensureFileBuffer()
+bool spConfigBase::openOutput(const std::string &filename)
 {
-  if (m_pFileBuf == nullptr)
+  m_ioFilename = filename;
+  if (m_pStorage)
   {
-    m_pFileBuf = (char*)malloc(SPCONFIG_FILEBUFSIZE);
-    if (m_pFileBuf == nullptr)
+    if (!SPCONFIG_STORAGE_CALL(openWrite, (m_ioFilename + ".tmp").c_str(), m_file))
     {
-      spLOGF_E("spConfigBase::ensureFileBuffer() could not allocate file buffer of size %d", SPCONFIG_FILEBUFSIZE);
+      m_ioFilename.clear();
       return false;
     }
   }
@@ -699,94 +2809,199 @@ bool spConfigBase::ensureFileBuffer()
 }
 
 /**
- * @brief release file buffer AND set to nullptr
+ * @brief write to the file opened for writing
  * 
+ * @param pos  position in file to start writing, which follows the data written before
+ * @param buf  buffer holding content to write
+ * @param len  number of bytes to write
+ * @return true / false  for all bytes written
  */
-void spConfigBase::freeFileBuffer()
+bool spConfigBase::writeOutput(size_t pos, char* buf, size_t len)
 {
-  free(m_pFileBuf);
-  m_pFileBuf = nullptr;
+  if (m_pStorage)
+  {
+    spConfigSpan data;
+    data.data = buf;
+    data.size = len;
+    return SPCONFIG_STORAGE_CALL(write, m_file, data);
+  }
+  return saveFile(m_ioFilename, buf, pos, len) == len;
 }
 
 /**
- * @brief callback function for each entry in store
+ * @brief close the file opened for writing, with a storage sync and rename the temporary file to replace 
+ *        the file, if committed, or remove it
  * 
- * @param id  ID used in store
- * @param cv  configvalue in store
- * @return true  for continue loop (as we want all values)
+ * @param commit  true to replace the file
+ * @return true / false  for the file replaced
  */
-bool spConfigBase::saveIniEntryCB(const std::string &id, const spConfigValue &cv)
+bool spConfigBase::closeOutput(bool commit)
 {
-
-  if (m_pFileBuf == nullptr)
+  if (!m_pStorage)
+  {
+    return commit;
+  }
+  if (m_ioFilename.empty())
   {
-    spLOG_E("spConfigBase::saveIniEntryCB() failed because no file buffer allocated");
     return false;
   }
-
-  int sIdx = id.find("#/#", 0);
-  if (sIdx == -1) // should not happen, but ...
+  std::string tmpFilename = m_ioFilename + ".tmp";
+  bool success = commit && SPCONFIG_STORAGE_CALL(sync, m_file);
+  success = SPCONFIG_STORAGE_CALL(close, m_file) && success;
+  success = success && SPCONFIG_STORAGE_CALL(rename, tmpFilename.c_str(), m_ioFilename.c_str());
+  if (!success)
   {
-    spLOGF_E("spConfigBase::saveIniEntryCB called with bad id %s", id.c_str());
-    return true;
+    SPCONFIG_STORAGE_CALL(remove, tmpFilename.c_str());
   }
-  std::string section = id.substr(0, sIdx);
-  std::string key = id.substr(sIdx + 3);
+  return success;
+}
 
-  // line string
-  std::string lineString = "";
-  char lineBuf[SPCONFIG_MAXLINELENGTH + 1];
-  size_t len;
+/**
+ * @brief return the name of a slot file, e.g. 'config.a' for 'config.a.ini'
+ * 
+ * @param slot  0 or 1
+ * @return std::string  name of file without path and extension
+ */
+std::string spConfigBase::slotName(int slot)
+{
+  return m_configFilename + (slot == 0 ? ".a" : ".b");
+}
 
+/**
+ * @brief read the header of a slot file, called with file access guarded
+ * 
+ * @param slot  0 or 1
+ * @param seq  sequence number of content
+ * @param len  length of content
+ * @param crc  CRC32 of content
+ * @return true / false  for a valid header
+ */
+bool spConfigBase::readSlotHeader(int slot, uint32_t &seq, uint32_t &len, uint32_t &crc)
+{
+  char header[SPCONFIG_SLOT_HEADERLEN + 1];
+  if (!openInput(makeFilename(slotName(slot))))
+  {
+    return false;
+  }
+  size_t received = readInput(0, header, SPCONFIG_SLOT_HEADERLEN);
+  closeInput();
+  if (received != SPCONFIG_SLOT_HEADERLEN)
+  {
+    return false;
+  }
+  header[SPCONFIG_SLOT_HEADERLEN] = 0;
+  unsigned int hSeq, hLen, hCrc;
+  if ((header[SPCONFIG_SLOT_HEADERLEN - 1] != '\n') || 
+      (sscanf(header, "#spConfigSlot seq=%8x len=%8x crc=%8x", &hSeq, &hLen, &hCrc) != 3))
+  {
+    return false;
+  }
+  seq = hSeq;
+  len = hLen;
+  crc = hCrc;
+  return true;
+}
 
-  // write new section
-  if (section.compare(m_lastSection) != 0)
+/**
+ * @brief check the content of a slot file against length and CRC of its header, called with file access guarded
+ * 
+ * @param slot  0 or 1
+ * @param len  length of content
+ * @param crc  CRC32 of content
+ * @return true / false  for complete and unchanged content
+ */
+bool spConfigBase::checkSlot(int slot, uint32_t len, uint32_t crc)
+{
+  if (!openInput(makeFilename(slotName(slot))))
   {
-    if (m_lastSection.length() > 0)
-    {
-      lineString = "\n";
-    }
-    m_lastSection = section;
-    len = snprintf(lineBuf, SPCONFIG_MAXLINELENGTH + 1, "[%s]\n", section.c_str());
-    if (len > SPCONFIG_MAXLINELENGTH)
+    return false;
+  }
+  uint32_t fileCrc = 0;
+  size_t remaining = len;
+  spConfigSpan content;
+  if (viewInput(content))
+  {
+    // whole content without reading it into the file buffer
+    if (content.size >= SPCONFIG_SLOT_HEADERLEN + (size_t)len)
     {
-      spLOGF_E("spConfigBase::saveIniEntryCB: section entry %s exceeds maximum line length of %i", lineBuf, SPCONFIG_MAXLINELENGTH);
+      fileCrc = crc32(fileCrc, content.data + SPCONFIG_SLOT_HEADERLEN, len);
+      remaining = 0;
     }
-    if (len > 0)
+  }
+  else if (ensureFileBuffer())
+  {
+    size_t fPos = SPCONFIG_SLOT_HEADERLEN;
+    while (remaining > 0)
     {
-      lineString.append(lineBuf);
+      size_t received = readInput(fPos, m_pFileBuf, (remaining < SPCONFIG_FILEBUFSIZE) ? remaining : SPCONFIG_FILEBUFSIZE);
+      if (received == 0)
+      {
+        break;
+      }
+      fileCrc = crc32(fileCrc, m_pFileBuf, received);
+      remaining -= received;
+      fPos += received;
     }
+    freeFileBuffer();
   }
+  closeInput();
+  return (remaining == 0) && (fileCrc == crc);
+}
 
-  // write key = value
-  len = snprintf(lineBuf, SPCONFIG_MAXLINELENGTH + 1, "%s=%s\n", key.c_str(), cv.c_str());
-  if (len > SPCONFIG_MAXLINELENGTH)
+/**
+ * @brief find the slot with the newest valid content by comparing the headers and checking only 
+ *        the content of the newer slot, unless it is invalid, called with file access guarded
+ * 
+ * @return std::string  name of slot file to read or of the configuration file, if no slot is valid
+ */
+std::string spConfigBase::selectSlot()
+{
+  uint32_t seq[2], len[2], crc[2];
+  bool valid[2];
+  for (int slot = 0; slot < 2; slot++)
   {
-    spLOGF_E("spConfigBase::saveIniEntryCB: entry %s exceeds maximum line length of %i", lineBuf, SPCONFIG_MAXLINELENGTH);
+    valid[slot] = readSlotHeader(slot, seq[slot], len[slot], crc[slot]);
   }
-  if (len > 0)
+  // newer by sequence number, allowing for wrap around
+  int newer = (valid[1] && (!valid[0] || ((int32_t)(seq[1] - seq[0]) > 0))) ? 1 : 0;
+  m_activeSlot = -1;
+  for (int slot : { newer, 1 - newer })
   {
-    lineString.append(lineBuf);
+    if (valid[slot] && checkSlot(slot, len[slot], crc[slot]))
+    {
+      m_activeSlot = slot;
+      m_slotSeq = seq[slot];
+      return slotName(slot);
+    }
+    if (valid[slot])
+    {
+      spLOGF_E("spConfigBase::selectSlot() found %s incomplete or corrupted", makeFilename(slotName(slot)).c_str());
+    }
   }
+  spLOGF_D("spConfigBase::selectSlot() found no valid slot, reading %s", makeFilename(m_configFilename).c_str());
+  return m_configFilename;
+}
 
-
-  len = lineString.length();
-  if (len > 0)
+/**
+ * @brief CRC32 (IEEE 802.3) of a buffer, continuing a CRC calculated before
+ * 
+ * @param crc  CRC of preceding data or 0
+ * @param buf 
+ * @param len  length of data in buffer
+ * @return uint32_t 
+ */
+uint32_t spConfigBase::crc32(uint32_t crc, const char* buf, size_t len)
+{
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++)
   {
-    // exceeding file buffer size?
-    if (m_fileBufUsed + len > SPCONFIG_FILEBUFSIZE)
+    crc ^= (uint8_t)buf[i];
+    for (int bit = 0; bit < 8; bit++)
     {
-      saveFile(m_filenameUsed, m_pFileBuf, m_fPos, m_fileBufUsed);
-      m_fPos += m_fileBufUsed;
-      m_fileBufUsed = 0;
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
     }
-    
-    // copy line to buffer
-    memcpy(m_pFileBuf + m_fileBufUsed, lineString.c_str(), len);
-    m_fileBufUsed += len;
   }
-  
-  return true;
+  return ~crc;
 }
 
 /**
@@ -802,7 +3017,7 @@ size_t spConfigBase::trimLine(char* buf, size_t len)
   // from end
   while (sLen > 0)
   {
-    if (!isspace(buf[sLen-1]))
+    if (!isspace((unsigned char)buf[sLen-1]))
     {
       break;
     }
@@ -814,7 +3029,7 @@ size_t spConfigBase::trimLine(char* buf, size_t len)
     int i = 0;
     while (i < sLen)
     {
-      if (!isspace(buf[i]))
+      if (!isspace((unsigned char)buf[i]))
       {
         if (i > 0)
         {
@@ -853,33 +3068,46 @@ size_t spConfigBase::eraseComments(char* buf, size_t len)
 }
 
 /**
- * @brief parse file into store
+ * @brief parse file into store, called with file access guarded
  * 
  * @param filename  file to parse
+ * @param store  store to add the values to
  * @return true / false  for success 
  */
-bool spConfigBase::parseIniFile(std::string filename)
+bool spConfigBase::parseIniFile(std::string filename, spConfigStore &store)
 {
 
-  if (!ensureFileBuffer())
+  m_filenameUsed = makeFilename(filename);
+  spLOGF_D("spConfigBase::parseIniFile() for %s", m_filenameUsed.c_str());    
+
+  if (!openInput(m_filenameUsed))
   {
-    spLOG_E("spConfigBase::parseIniFile() aborted");
     return false;
   }
-
-  m_filenameUsed = m_configFilePath + filename;
-  if (m_configFileExtension.length() > 0)
+  SPCONFIG_METRIC(auto startTime = std::chrono::steady_clock::now());
+  spConfigTraceScope trace(m_tracer, "parse", m_filenameUsed.c_str());
+
+  // content of file without copying it, if the storage provides it, or read in chunks into the file buffer
+  spConfigSpan content;
+  bool viewed = viewInput(content);
+  const char* pBuf = content.data;
+  size_t received = content.size;
+  if (!viewed)
   {
-    m_filenameUsed.append(".");
-    m_filenameUsed.append(m_configFileExtension);
+    if (!ensureFileBuffer())
+    {
+      spLOG_E("spConfigBase::parseIniFile() aborted");
+      closeInput();
+      return false;
+    }
+    pBuf = m_pFileBuf;
+    // attempt to read file
+    received = readInput(0, m_pFileBuf, SPCONFIG_FILEBUFSIZE);
   }
-  spLOGF_D("spConfigBase::parseIniFile() for %s", m_filenameUsed.c_str());    
-
-  // attempt to read file
-  int32_t received = readFile(m_filenameUsed, m_pFileBuf, 0, SPCONFIG_FILEBUFSIZE);
   if (received < 1)
   {
-  // release buffer and return failure
+    // release buffer and return failure
+    closeInput();
     freeFileBuffer();
     return false;
   }
@@ -894,14 +3122,23 @@ bool spConfigBase::parseIniFile(std::string filename)
   // pos in buffer
   size_t lPos = 0;
   size_t bPos = 0;
-  // string for content
-  std::string section = "";
-  std::string key = "";
-  std::string value = "";
+  // line exceeding the maximum length, skipped up to its end, which may be in the next chunk
+  bool lineTooLong = false;
+  // section name from the store's name pool, key and value in line buffer
+  const char* section = "";
+  size_t sectionLen = 0;
+  size_t keyLen = 0;
+  const char* value = "";
   // position of equal sign in key = value
-  size_t equalPos = -1;
+  size_t equalPos = 0;
   // len of string
-  size_t sLen = -1;
+  size_t sLen = 0;
+
+  // time of chunk and of adding its values to the store, only taken while tracing
+  bool tracing = trace.active();
+  uint64_t chunkStartUS = 0;
+  uint64_t chunkValues = 0;
+  uint64_t chunkInsertUS = 0;
 
   // with content in file
   while (received > 0)
@@ -909,34 +3146,60 @@ bool spConfigBase::parseIniFile(std::string filename)
     // new chunk to process
     bPos = 0;
     lPos = 0;
+    bool lastChunk = viewed || (received < SPCONFIG_FILEBUFSIZE);
+    if (tracing)
+    {
+      chunkStartUS = spConfigTracer::nowUS();
+      chunkValues = 0;
+      chunkInsertUS = 0;
+    }
     
     while (bPos < received)
     {
       // line by line
       lineLength = 0;
-      c = m_pFileBuf[bPos++];
+      bool lineEnd = false;
 
       // just looking \n = LF, as trimLine() will filter out \r = CR in Windows
-      while ((c != '\n') && (bPos <= received))
+      while (bPos < received)
       {
+        c = pBuf[bPos++];
+        if (c == '\n')
+        {
+          lineEnd = true;
+          break;
+        }
         if (lineLength < SPCONFIG_MAXLINELENGTH)
         {
           lineBuf[lineLength++] = c;
-          c = m_pFileBuf[bPos++];
         }
-        else
+        else if (!lineTooLong)
+        {
+          lineTooLong = true;
+          spLOGF_E("spConfigBase::parseIniFile(): line in %s starting with '%.*s...' exceeds maximum length of %d", m_filenameUsed.c_str(), 
+                   (int)((lineLength < 40) ? lineLength : 40), lineBuf, SPCONFIG_MAXLINELENGTH);
+        }
+      }
+
+      // line continues in next chunk, where it is read again or, when too long, skipped up to its end
+      if (!lineEnd && !lastChunk)
+      {
+        if (lineTooLong)
         {
-          lineBuf[40] = 0;
-          spLOGF_E("spConfigBase::parseIniFile(): line in %s starting with '%s...' exceeds maximum length of %d", m_filenameUsed.c_str(), lineBuf, SPCONFIG_MAXLINELENGTH);
-          c = '\n';
-        }        
+          lPos = bPos;
+        }
+        break;
+      }
+      // pos in buffer after full line completed, the last line of the file may have no line end
+      lPos = bPos;
+      if (lineTooLong)
+      {
+        lineTooLong = false;
+        continue;
       }
 
-      // new line end
-      if ((c == '\n') && (lineLength > 0))
+      if (lineLength > 0)
       {
-        // pos in buffer after full line completed
-        lPos = bPos;
         // parse line
         lineLength = eraseComments(lineBuf, lineLength);
         lineLength = trimLine(lineBuf, lineLength);
@@ -954,14 +3217,13 @@ bool spConfigBase::parseIniFile(std::string filename)
             {
               lineLength = 0; // empty or not ] closed, skip this section
             }
-            lineBuf[lineLength] = 0;
-            section = std::string(lineBuf);
+            sectionLen = lineLength;
+            section = store.getNamePool()->intern(lineBuf, sectionLen);
           } 
           // key = value text within a section
-          else if(section.length() > 0)
+          else if(sectionLen > 0)
           {
-            equalPos = -1;
-            sLen = -1;
+            equalPos = lineLength;
             for (size_t i = 0; i < lineLength; i++)
             {
               if(lineBuf[i] == '=')
@@ -975,27 +3237,23 @@ bool spConfigBase::parseIniFile(std::string filename)
               abc=de    lineLength  6
               ...e      equalPos    3
               abcdef    lineLength  6
-              ......    equalPos    -1 -> 6
+              ......    equalPos    6
               abcde=    lineLength  6
               .....e    equalPos    5
             */
 
-            // equalPos could be -1 for no value entry
-            if (equalPos == -1)
-            {
-              equalPos = lineLength;
-            }
+            // equalPos is lineLength for no value entry
             sLen = trimLine(lineBuf, equalPos); // possible right trim (before '=')
             if (sLen > 0) // only with key existing = chars left to use
             {
-              key = std::string(lineBuf, sLen);
+              keyLen = sLen;
               value = "";
               if (equalPos < lineLength)
               {
                 sLen = lineLength - equalPos - 1;
                 for (size_t i = equalPos+1; i < lineLength; i++)
                 {
-                  if (!isspace(lineBuf[i])) // possible left trim (after '=')
+                  if (!isspace((unsigned char)lineBuf[i])) // possible left trim (after '=')
                   {
                     break;
                   }
@@ -1003,40 +3261,98 @@ bool spConfigBase::parseIniFile(std::string filename)
                 }
                 if (sLen > 0)
                 {
-                  value = std::string(lineBuf + lineLength - sLen, sLen);
+                  lineBuf[lineLength] = 0;
+                  value = lineBuf + lineLength - sLen;
                 }
               }
-              // good to store with addObj to overwrite existing entry
-              m_store.addObjWithId(makeId(section.c_str(), key.c_str()), value.c_str());
+              // good to store with set to overwrite existing entry
+              uint64_t insertStartUS = tracing ? spConfigTracer::nowUS() : 0;
+              if (!store.set(spConfigKey(section, sectionLen, lineBuf, keyLen), value))
+              {
+                m_parseFailed = true;
+                break;
+              }
+              if (tracing)
+              {
+                chunkInsertUS += spConfigTracer::nowUS() - insertStartUS;
+                chunkValues++;
+              }
             }
           
           }
         }
 
-      } // if ((c == '\n') && (lineLength > 0))
+      } // if (lineLength > 0)
 
     } // while (bPos < received)
 
+    // values no longer fit into the memory budget, capacity or fixed memory
+    if (m_parseFailed)
+    {
+      closeInput();
+      freeFileBuffer();
+      return false;
+    }
+
     //done with file?
-    if (received < SPCONFIG_FILEBUFSIZE)
+    if (tracing)
+    {
+      m_tracer.emit("parseChunk", m_filenameUsed.c_str(), chunkStartUS, lastChunk ? received : lPos, chunkValues, chunkInsertUS);
+      trace.values += chunkValues;
+      trace.insertUS += chunkInsertUS;
+    }
+    if (lastChunk)
     {
+      SPCONFIG_METRIC(m_metrics.readBytes.fetch_add(m_fPos + received, std::memory_order_relaxed));
+      trace.bytes = m_fPos + received;
       received = 0;
     }
     else
     {
       m_fPos += lPos;
-      received = readFile(m_filenameUsed, m_pFileBuf, m_fPos, SPCONFIG_FILEBUFSIZE);
+      received = readInput(m_fPos, m_pFileBuf, SPCONFIG_FILEBUFSIZE);
     }
 
 
   } // while (received > 0)
   
   // release buffer and return success
+  closeInput();
   freeFileBuffer();
+  SPCONFIG_METRIC(m_metrics.readTime.record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count()));
   return true;
 }
 
 
+/**
+ * @brief save changed values for autosave, to be called by the task of the derived class instead of save()
+ * 
+ */
+void spConfigBase::autosave()
+{
+  spConfigTraceScope trace(m_tracer, "autosave");
+  SPCONFIG_METRIC(m_metrics.autosaves.fetch_add(1, std::memory_order_relaxed));
+  save();
+}
+
+/**
+ * @brief autosave, when values have changed and the time for the next autosave has passed, 
+ *        to be called regularly by the loop task of the derived class
+ * 
+ * @param nowMS  current time in ms since epoch
+ * @return true / false  for autosave done
+ */
+bool spConfigBase::autosaveIfDue(uint64_t nowMS)
+{
+  uint64_t timeMS = getNextAutosaveTimeMS();
+  if (!changed() || (timeMS == 0) || (nowMS <= timeMS))
+  {
+    return false;
+  }
+  autosave();
+  return true;
+}
+
 /**
  * @brief set the time for next autosave
  * 
@@ -1057,6 +3373,80 @@ uint64_t spConfigBase::getNextAutosaveTimeMS()
   return m_autosaveTimeMS;
 }
 
+/**
+ * @brief call subscribers for changes queued while notifications are asynchronous, 
+ *        to be called by the notification task of the derived class
+ * 
+ * @return true / false  for any changes dispatched
+ */
+bool spConfigBase::dispatchChanges()
+{
+  return m_notifier.dispatchQueued();
+}
+
+/**
+ * @brief return the files read by read() and reload(), i.e. the default configuration file and the 
+ *        configuration file or in slot mode the slot files, for watching them, 
+ *        none with a storage, whose files may not be on disk
+ * 
+ * @return std::vector<std::string>  filenames with path and extension
+ */
+std::vector<std::string> spConfigBase::getWatchFilenames()
+{
+  std::vector<std::string> filenames;
+  std::lock_guard<std::mutex> fileLock(m_fileMutex);
+  if (m_pStorage)
+  {
+    return filenames;
+  }
+  filenames.push_back(makeFilename(m_configDefaultFilename));
+  if (m_slotMode)
+  {
+    filenames.push_back(makeFilename(slotName(0)));
+    filenames.push_back(makeFilename(slotName(1)));
+  }
+  else
+  {
+    filenames.push_back(makeFilename(m_configFilename));
+  }
+  return filenames;
+}
+
+/**
+ * @brief returns whether a file is as written by the last save() to it, e.g. to ignore the change in watch mode
+ * 
+ * @param filename  filename with path and extension
+ * @param stamp  current time and size of the file
+ * @return true / false 
+ */
+bool spConfigBase::isOwnSave(const std::string &filename, const spConfigFileStamp &stamp)
+{
+  std::lock_guard<std::mutex> fileLock(m_fileMutex);
+  auto it = m_savedStamps.find(filename);
+  return (it != m_savedStamps.end()) && (it->second == stamp);
+}
+
+/**
+ * @brief return the last write time and size of a file
+ * 
+ * @param filename  filename with path and extension
+ * @return spConfigFileStamp  time and size or 0 for both, if the file does not exist
+ */
+spConfigFileStamp spConfigBase::fileStamp(const std::string &filename)
+{
+  spConfigFileStamp stamp;
+  std::error_code ec;
+  std::filesystem::file_time_type time = std::filesystem::last_write_time(filename, ec);
+  if (ec)
+  {
+    return stamp;
+  }
+  uintmax_t size = std::filesystem::file_size(filename, ec);
+  stamp.time = time.time_since_epoch().count();
+  stamp.size = ec ? 0 : size;
+  return stamp;
+}
+
 /**
  * @brief base function to return usability of the file system
  *        can override in derived class, where this needs to be verified
@@ -1117,3 +3507,33 @@ void spConfigBase::ensureLoopTask()
 {
   // for derived class to do
 }
+
+/**
+ * @brief base function to create a notification task if needed, which calls dispatchChanges()
+ *        should be overriden by derived class
+ * 
+ */
+void spConfigBase::ensureNotifyTask()
+{
+  // for derived class to do
+}
+
+/**
+ * @brief base function to act on a change queued for the notification task
+ *        can override in derived class, e.g. to wake up the task
+ * 
+ */
+void spConfigBase::onChangeQueued()
+{
+}
+
+/**
+ * @brief base function to create a watch task if needed, which calls reload() after changes of
+ *        the configuration files
+ *        should be overriden by derived class
+ * 
+ */
+void spConfigBase::ensureWatchTask()
+{
+  // for derived class to do
+}
@@ -2,8 +2,8 @@
  * @file spConfigBase.h
  * @author krokoreit (krokoreit@gmail.com)
  * @brief class to handle configuration data
- * @version 2.1.3
- * @date 2024-10-23
+ * @version 2.2.0
+ * @date 2026-10-18
  * @copyright Copyright (c) 2024
  * 
  * Version history:
@@ -13,6 +13,11 @@
  * v2.1.1   replaced printf() with spLogHelper
  * v2.1.2   minor updates
  * v2.1.3   align versioning
+ * v2.2.0   replaced spObjectStore with spConfigStore for hashed lookups by spConfigKey
+ *          defaults in a layer of their own, shareable and compiled into the binary
+ *          override values, change subscriptions, reload() and freeze()
+ *          memory resources, fixed memory and memory budget for values
+ *          storage backends, slot mode, metrics, tracing and profiling
  *  
  */
 
@@ -25,10 +30,26 @@
 #include <string>
 #include <string.h>
 #include <functional>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 
 #include <spLogHelper.h>
-#include <spObjectStore.h>
+#include <spConfigKey.h>
 #include <spConfigValue.h>
+#include <spConfigStore.h>
+#include <spConfigFixedMemory.h>
+#include <spConfigStorage.h>
+#include <spConfigMetrics.h>
+#include <spConfigTrace.h>
+#include <spConfigProfile.h>
+#include <spConfigFrozen.h>
+#include <spConfigDefaults.h>
+#include <spConfigNotifier.h>
+#include <map>
+#include <set>
+#include <vector>
 
 
 // SPCONFIG_FILEPATH_SEPARATOR for Windows and if not already defined
@@ -52,15 +73,88 @@
   #define SPCONFIG_FILEBUFSIZE  1200
 #endif
 
+// a line must fit into the file buffer to be parsed when it continues in the next chunk
+#if SPCONFIG_FILEBUFSIZE <= SPCONFIG_MAXLINELENGTH
+  #error "SPCONFIG_FILEBUFSIZE must exceed SPCONFIG_MAXLINELENGTH"
+#endif
+
+// define SPCONFIG_FIXED_MEMORY to keep the file buffer in the config object instead of allocating 
+// it for every read and save, see setFixedMemory() for values
+
+// define SPCONFIG_STORAGE as a storage class, e.g. spConfigPosixStorage, to access files through 
+// a storage of the config object instead of readFile() and saveFile(), called without virtual dispatch, see setStorage()
+
+// header of slot files, an ini comment with sequence number, length and CRC32 of the content following
+#define SPCONFIG_SLOT_HEADER  "#spConfigSlot seq=%08x len=%08x crc=%08x\n"
+#define SPCONFIG_SLOT_HEADERLEN  53
+
+// bytes of the arena of the store no longer used by values, from which on the store is compacted, see setMemoryResource()
+#ifndef SPCONFIG_ARENA_COMPACT_MIN
+  #define SPCONFIG_ARENA_COMPACT_MIN  4096
+#endif
+
+#ifndef SPCONFIG_WATCH_DEBOUNCE_MS
+  #define SPCONFIG_WATCH_DEBOUNCE_MS  500
+#endif
+
+#ifndef SPCONFIG_WATCH_POLL_MS
+  #define SPCONFIG_WATCH_POLL_MS  1000
+#endif
+
+
+// last write time and size of a file, to tell changes by others from those of save()
+struct spConfigFileStamp
+{
+  int64_t time = 0;
+  uintmax_t size = 0;
+  bool operator ==(const spConfigFileStamp &stamp) const { return (time == stamp.time) && (size == stamp.size); }
+  bool operator !=(const spConfigFileStamp &stamp) const { return !(*this == stamp); }
+};
+
 
 class spConfigBase
 {
   private:
-    spObjectStore<spConfigValue> m_store;
+    // values by section and key, used to find differences after replacing all values
+    typedef std::map<std::pair<std::string, std::string>, std::string> ValueMap;
+    // change of the value returned by the getters after setting or clearing override values
+    struct OverrideChange
+    {
+      std::string section;
+      std::string key;
+      spConfigValue oldValue;
+      spConfigValue newValue;
+      bool hasOldValue;
+      bool hasNewValue;
+    };
+    spConfigNamePoolPtr m_pNamePool;
+    std::pmr::memory_resource* m_pMemoryResource = nullptr; // upstream of arenas for loaded values
+    spConfigFixedMemory* m_pFixedMemory = nullptr; // memory for stores of fixed capacity
+    size_t m_fixedCapacity = 0;
+    std::shared_ptr<spConfigStore> m_pStore;
+    spConfigStore m_overrides;
+    bool m_hasOverrides = false;
+    std::shared_ptr<spConfigDefaults> m_pDefaults;
+    std::shared_ptr<spConfigFrozen> m_pFrozen;
+    std::atomic<bool> m_sharedDefaults{false};
+    const spConfigDefaultEntry* m_pDefaultTable = nullptr;
+    size_t m_defaultTableCount = 0;
+    spConfigNotifier m_notifier;
     spConfigValue m_non_existant_configValue = "non existant";
-    bool m_hasChanged = false;
-    bool m_autosave = false;
-    uint64_t m_autosaveTimeMS = 0;
+    std::atomic<bool> m_hasChanged{false};
+    // keys changed or removed since the last save, kept by reload(), changed with stores guarded exclusively 
+    // or by writeIniFile() with file access guarded
+    std::set<std::pair<std::string, std::string>> m_dirtyKeys;
+    std::map<std::string, spConfigFileStamp> m_savedStamps; // files written by save(), guarded by file mutex
+    std::atomic<bool> m_autosave{false};
+    std::atomic<uint64_t> m_autosaveTimeMS{0};
+    std::atomic<bool> m_watch{false};
+    std::atomic<bool> m_slotMode{false};
+    int m_activeSlot = -1; // slot with newest valid content or -1 if unknown, guarded by file mutex
+    uint32_t m_slotSeq = 0;
+    std::atomic<uint64_t> m_generation{0};
+    std::shared_mutex m_storeMutex; // guards stores and overrides
+    std::mutex m_fileMutex; // guards file buffer and file access
     std::string m_configFilePath = "";
     std::string m_configFilename = "config";
     std::string m_configDefaultFilename = "config-default";
@@ -68,55 +162,183 @@ class spConfigBase
     std::string m_filenameUsed = "";
     size_t m_fileBufUsed = 0; // size of file buffer used 
     char *m_pFileBuf = nullptr; // pointer to file buffer
+#ifdef SPCONFIG_FIXED_MEMORY
+    char m_fileBuf[SPCONFIG_FILEBUFSIZE]; // file buffer used instead of allocating one
+#endif
     size_t m_fPos = 0; // position inside file 
+    spConfigStorage* m_pStorage = nullptr; // storage for file access or nullptr to use readFile() and saveFile()
+#ifdef SPCONFIG_STORAGE
+    SPCONFIG_STORAGE m_storage; // storage selected at compile time
+#endif
+    spConfigFile m_file; // file opened in storage
+    std::string m_ioFilename; // name of file opened
     std::string m_lastSection;
+    bool m_measureSave = false; // save pass only calculating length and CRC of content
+    size_t m_saveLen = 0;
+    uint32_t m_saveCrc = 0;
+    bool m_saveFailed = false;
+    bool m_parseFailed = false; // values not stored while parsing, as the memory budget, capacity or fixed memory would be exceeded
+    std::atomic<size_t> m_memoryBudget{0};
+#ifndef SPCONFIG_NO_METRICS
+    spConfigMetrics m_metrics;
+#endif
+    spConfigTracer m_tracer;
+    spConfigProfile m_profile;
+    std::atomic<bool> m_profiling{false};
     // 
     void setChanged();
-    std::string makeId(const char* section, const char* key);
+    spConfigValue* findValue(const spConfigKey &key);
+    spConfigValue* findStoredValue(const spConfigKey &key);
+    bool storeValue(const spConfigKey &key, const spConfigValue &value, std::unique_lock<std::shared_mutex> &lock);
+    void compactStore();
+    void nextGeneration();
+    bool rejectFrozen(const char* function);
+    std::shared_ptr<spConfigFrozen> buildFrozen(const spConfigStore* pStore, const spConfigDefaults* pDefaults);
+    bool swapFrozen(const spConfigStore* pNewStore, const spConfigDefaults* pNewDefaults);
+    std::shared_ptr<spConfigDefaults> newDefaults();
+    std::shared_ptr<spConfigDefaults> stageDefaults();
+    std::shared_ptr<spConfigStore> stageStore(const spConfigDefaults* pNewDefaults);
+    size_t storeBudget(const spConfigDefaults* pDefaults);
+    bool swapGeneration(std::shared_ptr<spConfigStore> pNewStore, std::shared_ptr<spConfigDefaults> pNewDefaults);
+    void markDirty(const spConfigKey &key);
+    void collectValues(ValueMap &values);
+    void collectKeyReads(std::vector<spConfigKeyReads> &keys);
+    void notifyDifferences(const ValueMap &oldValues);
+    void notifyChange(const spConfigKey &key, const spConfigValue* pOldValue, const spConfigValue* pNewValue);
+    void applyOverrides(const ValueMap &overrides);
+    void notifyOverrideChanges(const std::vector<OverrideChange> &changes);
     bool ensureFileBuffer();
     void freeFileBuffer();
-    bool saveIniEntryCB(const std::string &id, const spConfigValue &cv);
+    size_t countDifferences(const spConfigStore &store1, const spConfigStore &store2);
+    std::string makeFilename(const std::string &name);
+    void writeIniFile();
+    bool saveIniEntryCB(const char* section, const char* key, const spConfigValue &cv);
+    void writeText(const char* text, size_t len);
+    void flushFileBuffer();
+    bool openInput(const std::string &filename);
+    bool viewInput(spConfigSpan &content);
+    size_t readInput(size_t pos, char* buf, size_t len);
+    void closeInput();
+    bool openOutput(const std::string &filename);
+    bool writeOutput(size_t pos, char* buf, size_t len);
+    bool closeOutput(bool commit);
+    std::string slotName(int slot);
+    bool readSlotHeader(int slot, uint32_t &seq, uint32_t &len, uint32_t &crc);
+    bool checkSlot(int slot, uint32_t len, uint32_t crc);
+    std::string selectSlot();
+    static uint32_t crc32(uint32_t crc, const char* buf, size_t len);
     size_t trimLine(char* buf, size_t len);
     size_t eraseComments(char* buf, size_t len);
-    bool parseIniFile(std::string filename);
+    bool parseIniFile(std::string filename, spConfigStore &store);
 
   protected:
+    void autosave();
+    bool autosaveIfDue(uint64_t nowMS);
     void setNextAutosaveTimeMS(uint64_t timeMS);
     uint64_t getNextAutosaveTimeMS();
+    bool dispatchChanges();
+    std::vector<std::string> getWatchFilenames();
+    bool isOwnSave(const std::string &filename, const spConfigFileStamp &stamp);
+    static spConfigFileStamp fileStamp(const std::string &filename);
     // virtuals
     virtual bool canUseFS();
     virtual void onSetChanged();
     virtual size_t readFile(std::string filename, char* buf, size_t startPos, size_t maxBytes);
     virtual size_t saveFile(std::string filename, char* buf, size_t startPos, size_t writeBytes);
     virtual void ensureLoopTask();
+    virtual void ensureNotifyTask();
+    virtual void onChangeQueued();
+    virtual void ensureWatchTask();
 
   public:
     spConfigBase();
     ~spConfigBase();
-    void setValue(const char* section, const char* key, const char* value);
-    void setValue(const char* section, const char* key, int32_t value);
-    void setValue(const char* section, const char* key, uint32_t value);
-    void setValue(const char* section, const char* key, int64_t value);
-    void setValue(const char* section, const char* key, uint64_t value);
-    void setValue(const char* section, const char* key, double value);
-    void setValue(const char* section, const char* key, bool value);
+    bool setValue(const char* section, const char* key, const char* value);
+    bool setValue(const char* section, const char* key, int32_t value);
+    bool setValue(const char* section, const char* key, uint32_t value);
+    bool setValue(const char* section, const char* key, int64_t value);
+    bool setValue(const char* section, const char* key, uint64_t value);
+    bool setValue(const char* section, const char* key, double value);
+    bool setValue(const char* section, const char* key, bool value);
+    bool setValue(const spConfigKey &key, const char* value);
+    bool setValue(const spConfigKey &key, int32_t value);
+    bool setValue(const spConfigKey &key, uint32_t value);
+    bool setValue(const spConfigKey &key, int64_t value);
+    bool setValue(const spConfigKey &key, uint64_t value);
+    bool setValue(const spConfigKey &key, double value);
+    bool setValue(const spConfigKey &key, bool value);
 
     spConfigValue* getConfigValue(const char* section, const char* key);
     const char* getCStr(const char* section, const char* key, const char* defaultValue = "");
     std::string getString(const char* section, const char* key, const char* defaultValue = "");
     int32_t getInt32(const char* section, const char* key, int32_t defaultValue = 0);
-    int32_t getUInt32(const char* section, const char* key, uint32_t defaultValue = 0);
+    uint32_t getUInt32(const char* section, const char* key, uint32_t defaultValue = 0);
     int64_t getInt64(const char* section, const char* key, int64_t defaultValue = 0);
-    int64_t getUInt64(const char* section, const char* key, uint64_t defaultValue = 0);
+    uint64_t getUInt64(const char* section, const char* key, uint64_t defaultValue = 0);
     double getDouble(const char* section, const char* key, double defaultValue = 0.0);
     bool getBool(const char* section, const char* key, bool defaultValue = false);
     bool exists(const char* section, const char* key);
+    spConfigValue* getConfigValue(const spConfigKey &key);
+    const char* getCStr(const spConfigKey &key, const char* defaultValue = "");
+    std::string getString(const spConfigKey &key, const char* defaultValue = "");
+    int32_t getInt32(const spConfigKey &key, int32_t defaultValue = 0);
+    uint32_t getUInt32(const spConfigKey &key, uint32_t defaultValue = 0);
+    int64_t getInt64(const spConfigKey &key, int64_t defaultValue = 0);
+    uint64_t getUInt64(const spConfigKey &key, uint64_t defaultValue = 0);
+    double getDouble(const spConfigKey &key, double defaultValue = 0.0);
+    bool getBool(const spConfigKey &key, bool defaultValue = false);
+    bool exists(const spConfigKey &key);
+    void forEachInSection(const char* section, std::function<bool(const char* key, const spConfigValue &value)> callback);
+    void forEachSection(std::function<bool(const char* section)> callback);
+    bool removeValue(const char* section, const char* key);
+    bool removeValue(const spConfigKey &key);
+    size_t removeSection(const char* section);
+    spConfigNamePoolPtr getNamePool();
+    void setNamePool(spConfigNamePoolPtr pNames);
+    std::pmr::memory_resource* getMemoryResource();
+    void setMemoryResource(std::pmr::memory_resource* pResource);
+    bool setFixedMemory(spConfigFixedMemory* pMemory, size_t capacity);
+    spConfigMemoryUsage memoryUsage();
+    size_t getMemoryBudget();
+    void setMemoryBudget(size_t bytes);
+    spConfigMetricsSnapshot getMetrics();
+    void resetMetrics();
+    void setTraceCallback(spConfigTraceCallback callback);
+    bool setProfiling(bool profiling, uint32_t sampleRate = 1);
+    bool getProfiling();
+    std::vector<spConfigKeyReads> getHotKeys(size_t count = 10);
+    std::vector<spConfigKeyReads> getUnusedKeys();
+    uint64_t getUncountedReads();
+    void resetProfile();
+    spConfigStorage* getStorage();
+    void setStorage(spConfigStorage* pStorage);
+    spConfigDefaultsPtr getDefaults();
+    void setDefaults(spConfigDefaultsPtr pDefaults);
+    void setDefaults(const spConfigDefaultEntry* table, size_t count);
+    template <size_t N> void setDefaults(const spConfigDefaultEntry (&table)[N]) { setDefaults(table, N); }
+    void setOverride(const char* section, const char* key, const char* value);
+    size_t addEnvOverrides(const char* prefix, char** envp = nullptr);
+    size_t addArgOverrides(int argc, char* argv[]);
+    void clearOverrides();
+    uint64_t getGeneration();
+    bool freeze();
+    void thaw();
+    bool frozen();
     bool changed();
-    void reset();
-    void read();
+    bool reset();
+    bool read();
     void save();
+    bool reload();
+    bool setWatch(bool watch);
+    bool getWatch();
     bool setAutosave(bool autosave);
     bool getAutosave();
+    bool setSlotMode(bool slotMode);
+    bool getSlotMode();
+    uint32_t subscribe(const char* section, const char* key, spConfigChangeCallback callback);
+    bool unsubscribe(uint32_t subscriptionId);
+    bool setNotifyAsync(bool async);
+    bool getNotifyAsync();
     void setConfigFilename(std::string newName);
     std::string getConfigFilename();
     void setConfigDefaultFilename(std::string newName);
@@ -0,0 +1,151 @@
+/**
+ * @file spConfigBinding.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class template to bind the keys of a config section to the members of a struct
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version for binding sections to structs
+ * 
+ */
+
+
+#ifndef SPCONFIGBINDING_H
+#define SPCONFIGBINDING_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <memory>
+#include <atomic>
+
+#include <spConfigBase.h>
+
+
+/**
+ * @brief table of fields, which maps the keys of a section to members of struct S, e.g.
+ *          spConfigBinding<NetSettings> netBinding("net");
+ *          netBinding.field("timeout", &NetSettings::timeout).field("host", &NetSettings::host);
+ *          netBinding.read(config, netSettings);
+ *        members without value in the config object keep their current value
+ * 
+ * @tparam S  struct type
+ */
+template <typename S>
+class spConfigBinding
+{
+  private:
+    typedef std::function<void(S &target, const spConfigValue &value)> FieldAssign;
+    std::string m_section;
+    std::vector<FieldAssign> m_fields;
+    std::unordered_map<std::string, size_t> m_fieldIndex;
+
+    spConfigBinding& addField(const char* key, FieldAssign assign)
+    {
+      m_fieldIndex[key] = m_fields.size();
+      m_fields.push_back(assign);
+      return *this;
+    }
+
+  public:
+    spConfigBinding(const char* section) : m_section(section)
+    {
+    }
+
+    spConfigBinding& field(const char* key, std::string S::*member)
+    {
+      return addField(key, [member](S &target, const spConfigValue &value) { target.*member = value.asString(); });
+    }
+
+    spConfigBinding& field(const char* key, int32_t S::*member)
+    {
+      return addField(key, [member](S &target, const spConfigValue &value) { target.*member = value.asInt32(); });
+    }
+
+    spConfigBinding& field(const char* key, uint32_t S::*member)
+    {
+      return addField(key, [member](S &target, const spConfigValue &value) { target.*member = value.asUInt32(); });
+    }
+
+    spConfigBinding& field(const char* key, int64_t S::*member)
+    {
+      return addField(key, [member](S &target, const spConfigValue &value) { target.*member = value.asInt64(); });
+    }
+
+    spConfigBinding& field(const char* key, uint64_t S::*member)
+    {
+      return addField(key, [member](S &target, const spConfigValue &value) { target.*member = value.asUInt64(); });
+    }
+
+    spConfigBinding& field(const char* key, double S::*member)
+    {
+      return addField(key, [member](S &target, const spConfigValue &value) { target.*member = value.asDouble(); });
+    }
+
+    spConfigBinding& field(const char* key, bool S::*member)
+    {
+      return addField(key, [member](S &target, const spConfigValue &value) { target.*member = value.asBool(); });
+    }
+
+    /**
+     * @brief populate the members of target in one pass over the section's values
+     * 
+     * @param config  config object
+     * @param target  struct to populate
+     * @return size_t  number of members set
+     */
+    size_t read(spConfigBase &config, S &target) const
+    {
+      size_t count = 0;
+      config.forEachInSection(m_section.c_str(), [this, &target, &count](const char* key, const spConfigValue &value) {
+        auto it = m_fieldIndex.find(key);
+        if (it != m_fieldIndex.end())
+        {
+          m_fields[it->second](target, value);
+          count++;
+        }
+        return true;
+      });
+      return count;
+    }
+
+    /**
+     * @brief populate the members of target and subscribe to changes of the section to populate them again,
+     *        the binding is copied, but target must remain valid until unsubscribe() with the ID returned
+     * 
+     * @param config  config object
+     * @param target  struct to populate
+     * @param onUpdate  optional function called after target was populated again
+     * @return uint32_t  subscription ID
+     */
+    uint32_t bind(spConfigBase &config, S &target, std::function<void(S &target)> onUpdate = nullptr) const
+    {
+      read(config, target);
+      spConfigBinding binding = *this;
+      // shared, as callbacks are copied when called
+      std::shared_ptr<std::atomic<uint64_t>> pGeneration = std::make_shared<std::atomic<uint64_t>>(config.getGeneration());
+      return config.subscribe(m_section.c_str(), nullptr, 
+                              [binding, &config, &target, onUpdate, pGeneration](const char*, const char*, const spConfigValue*, const spConfigValue*) {
+        // read() etc. notify every key changed, populate once per generation
+        uint64_t newGeneration = config.getGeneration();
+        if (pGeneration->exchange(newGeneration) == newGeneration)
+        {
+          return;
+        }
+        binding.read(config, target);
+        if (onUpdate)
+        {
+          onUpdate(target);
+        }
+      });
+    }
+
+};
+
+#endif // SPCONFIGBINDING_H
+
+
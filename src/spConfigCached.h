@@ -0,0 +1,113 @@
+/**
+ * @file spConfigCached.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class template to hold a config value with its type, only looked up again after changes
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version for cached typed accessors
+ * 
+ */
+
+
+#ifndef SPCONFIGCACHED_H
+#define SPCONFIGCACHED_H
+
+#include <stdint.h>
+#include <string>
+
+#include <spConfigBase.h>
+
+
+/**
+ * @brief typed accessor for a config value, e.g. 
+ *          spConfigCached<int32_t> timeout(config, "net", "timeout", 30);
+ *          ... timeout.get() ...
+ *        the value is only looked up again, when the generation of the config object has changed,
+ *        otherwise get() is one atomic load and a compare
+ *        an accessor object is meant to be used by one thread only
+ * 
+ * @tparam T  one of std::string, int32_t, uint32_t, int64_t, uint64_t, double or bool
+ */
+template <typename T>
+class spConfigCached
+{
+  private:
+    spConfigBase &m_config;
+    std::string m_section;
+    std::string m_key;
+    T m_defaultValue;
+    T m_value;
+    uint64_t m_generation = UINT64_MAX;
+    T lookup();
+
+  public:
+    spConfigCached(spConfigBase &config, const char* section, const char* key, T defaultValue = T()) :
+      m_config(config), m_section(section), m_key(key), m_defaultValue(defaultValue), m_value(defaultValue)
+    {
+    }
+
+    /**
+     * @brief return the value, looked up again only after changes of the config object
+     * 
+     * @return T  value
+     */
+    const T& get()
+    {
+      // load generation before the value, so a change in between leads to a new lookup next time
+      uint64_t generation = m_config.getGeneration();
+      if (generation != m_generation)
+      {
+        m_value = lookup();
+        m_generation = generation;
+      }
+      return m_value;
+    }
+
+    operator const T&()
+    {
+      return get();
+    }
+
+};
+
+template <> inline std::string spConfigCached<std::string>::lookup()
+{
+  return m_config.getString(m_section.c_str(), m_key.c_str(), m_defaultValue.c_str());
+}
+
+template <> inline int32_t spConfigCached<int32_t>::lookup()
+{
+  return m_config.getInt32(m_section.c_str(), m_key.c_str(), m_defaultValue);
+}
+
+template <> inline uint32_t spConfigCached<uint32_t>::lookup()
+{
+  return m_config.getUInt32(m_section.c_str(), m_key.c_str(), m_defaultValue);
+}
+
+template <> inline int64_t spConfigCached<int64_t>::lookup()
+{
+  return m_config.getInt64(m_section.c_str(), m_key.c_str(), m_defaultValue);
+}
+
+template <> inline uint64_t spConfigCached<uint64_t>::lookup()
+{
+  return m_config.getUInt64(m_section.c_str(), m_key.c_str(), m_defaultValue);
+}
+
+template <> inline double spConfigCached<double>::lookup()
+{
+  return m_config.getDouble(m_section.c_str(), m_key.c_str(), m_defaultValue);
+}
+
+template <> inline bool spConfigCached<bool>::lookup()
+{
+  return m_config.getBool(m_section.c_str(), m_key.c_str(), m_defaultValue);
+}
+
+#endif // SPCONFIGCACHED_H
+
+
@@ -0,0 +1,92 @@
+/**
+ * @file spConfigDefaults.cpp
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to hold a read-only layer of default configuration values
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <spConfigDefaults.h>
+
+
+/*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
+
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx      xxxxxx 
+      xx    xx  xx    xx  xx    xx  xx           xx     xx    xx
+      xx    xx  xx    xx  xx    xx  xx           xx     xx      
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx    xx
+      xx         xxxxxx   xxxxxxx   xxxxxxxx     xx      xxxxxx 
+     
+
+      PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
+
+
+spConfigDefaults::spConfigDefaults(spConfigNamePoolPtr pNames, std::pmr::memory_resource* pUpstream) : 
+    m_store(pNames, pUpstream)
+{
+}
+
+spConfigDefaults::spConfigDefaults(spConfigNamePoolPtr pNames, spConfigFixedMemory* pFixed, size_t capacity) : 
+    m_store(pNames, pFixed, capacity)
+{
+}
+
+/**
+ * @brief return number of default values
+ * 
+ * @return size_t 
+ */
+size_t spConfigDefaults::count() const
+{
+  return m_store.count();
+}
+
+
+
+/*    PRIVATE    PRIVATE    PRIVATE    PRIVATE
+
+      xxxxxxx   xxxxxxx      xx     xx    xx     xx     xxxxxxxx  xxxxxxxx
+      xx    xx  xx    xx     xx     xx    xx    xxxx       xx     xx      
+      xx    xx  xx    xx     xx     xx    xx   xx  xx      xx     xx      
+      xxxxxxx   xxxxxxx      xx      xx  xx   xx    xx     xx     xxxxxxx    
+      xx        xx    xx     xx      xx  xx   xxxxxxxx     xx     xx    
+      xx        xx    xx     xx       xxxx    xx    xx     xx     xx      
+      xx        xx    xx     xx        xx     xx    xx     xx     xxxxxxxx
+     
+
+      PRIVATE    PRIVATE    PRIVATE    PRIVATE    */
+
+
+/**
+ * @brief return the default value for section and key
+ * 
+ * @param key  section and key with hash
+ * @return spConfigValue*  pointer to value or nullptr if no default exists
+ */
+spConfigValue* spConfigDefaults::find(const spConfigKey &key) const
+{
+  return m_store.find(key);
+}
+
+/**
+ * @brief add the values of a default table, entries without value are skipped
+ * 
+ * @param table  array of entries
+ * @param count  number of entries
+ * @return true / false  for all values stored, false when exceeding memory limits
+ */
+bool spConfigDefaults::addTable(const spConfigDefaultEntry* table, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    if ((table[i].value != nullptr) && !m_store.set(table[i].key, table[i].value))
+    {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file spConfigDefaults.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to hold a read-only layer of default configuration values
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version for sharing defaults between spConfigBase objects
+ *          added spConfigDefaultEntry for default tables compiled into the binary
+ * 
+ */
+
+
+#ifndef SPCONFIGDEFAULTS_H
+#define SPCONFIGDEFAULTS_H
+
+#include <string>
+#include <memory>
+
+#include <spConfigStore.h>
+
+
+// entry of a default table, e.g. as generated by spconfig_embed_defaults() in spConfigEmbedDefaults.cmake,
+// with the key's hash calculated at compile time for constexpr tables
+struct spConfigDefaultEntry
+{
+  spConfigKey key;
+  const char* value;
+};
+
+class spConfigDefaults
+{
+  friend class spConfigBase;
+
+  private:
+    // only filled by spConfigBase before being published, lookups only afterwards
+    spConfigStore m_store;
+    spConfigValue* find(const spConfigKey &key) const;
+    bool addTable(const spConfigDefaultEntry* table, size_t count);
+
+  public:
+    spConfigDefaults(spConfigNamePoolPtr pNames = nullptr, std::pmr::memory_resource* pUpstream = nullptr);
+    spConfigDefaults(spConfigNamePoolPtr pNames, spConfigFixedMemory* pFixed, size_t capacity);
+    size_t count() const;
+
+};
+
+// reference counted handle to share one defaults layer between many spConfigBase objects
+typedef std::shared_ptr<const spConfigDefaults> spConfigDefaultsPtr;
+
+#endif // SPCONFIGDEFAULTS_H
+
+
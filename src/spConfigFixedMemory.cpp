@@ -0,0 +1,317 @@
+/**
+ * @file spConfigFixedMemory.cpp
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to provide memory from caller-provided static storage
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <spConfigFixedMemory.h>
+#include <stdlib.h>
+
+
+// failed allocations are reported to the caller as std::bad_alloc, if exceptions are enabled
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+  #define SPCONFIG_EXCEPTIONS 1
+#endif
+
+
+/*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
+
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx      xxxxxx 
+      xx    xx  xx    xx  xx    xx  xx           xx     xx    xx
+      xx    xx  xx    xx  xx    xx  xx           xx     xx      
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx    xx
+      xx         xxxxxx   xxxxxxx   xxxxxxxx     xx      xxxxxx 
+     
+
+      PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
+
+
+/**
+ * @brief Construct a new fixed memory object handing out blocks of the storage given, which 
+ *        must remain valid while the memory is used, e.g. a static array
+ * 
+ * @param buffer  storage
+ * @param size  size of storage in bytes
+ */
+spConfigFixedMemory::spConfigFixedMemory(void* buffer, size_t size)
+{
+  if ((buffer == nullptr) || (size < SPCONFIG_FIXEDMEMORY_BLOCKSIZE * 2))
+  {
+    spLOGF_E("spConfigFixedMemory storage of %u bytes is too small", (unsigned int)size);
+    return;
+  }
+  // each block needs its size plus one bit, the blocks start at the next block boundary after the bits
+  uintptr_t start = (uintptr_t)buffer;
+  uintptr_t end = start + size;
+  size_t blockCount = (size * 8) / (SPCONFIG_FIXEDMEMORY_BLOCKSIZE * 8 + 1);
+  size_t usedBytes = (blockCount + 7) / 8;
+  uintptr_t blocks = (start + usedBytes + SPCONFIG_FIXEDMEMORY_BLOCKSIZE - 1) & ~(uintptr_t)(SPCONFIG_FIXEDMEMORY_BLOCKSIZE - 1);
+  while ((blockCount > 0) && (blocks + blockCount * SPCONFIG_FIXEDMEMORY_BLOCKSIZE > end))
+  {
+    blockCount--;
+  }
+  m_pUsed = (uint8_t*)buffer;
+  memset(m_pUsed, 0, usedBytes);
+  m_pBlocks = (char*)blocks;
+  m_blockCount = blockCount;
+}
+
+/**
+ * @brief return number of bytes available in blocks
+ * 
+ * @return size_t 
+ */
+size_t spConfigFixedMemory::capacity() const
+{
+  return m_blockCount * SPCONFIG_FIXEDMEMORY_BLOCKSIZE;
+}
+
+/**
+ * @brief return number of bytes in blocks currently used
+ * 
+ * @return size_t 
+ */
+size_t spConfigFixedMemory::used() const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  return m_usedBlocks * SPCONFIG_FIXEDMEMORY_BLOCKSIZE;
+}
+
+/**
+ * @brief return the largest number of bytes in blocks used at any time, e.g. to size the storage
+ * 
+ * @return size_t 
+ */
+size_t spConfigFixedMemory::peak() const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  return m_peakBlocks * SPCONFIG_FIXEDMEMORY_BLOCKSIZE;
+}
+
+/**
+ * @brief return number of allocations failed for lack of memory
+ * 
+ * @return size_t 
+ */
+size_t spConfigFixedMemory::failures() const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  return m_failures;
+}
+
+/**
+ * @brief check whether allocations of the sizes given, made one after the other, would succeed, 
+ *        counting a failure otherwise, so callers can refuse a change instead of running out of memory
+ *        the result only holds while the memory is locked, see lock()
+ * 
+ * @param sizes  number of bytes of each allocation
+ * @param count  number of allocations, up to SPCONFIG_FIXEDMEMORY_MAXFITS
+ * @return true / false  for all allocations fitting
+ */
+bool spConfigFixedMemory::fits(const size_t* sizes, size_t count)
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  // runs are taken as do_allocate() would and given back afterwards
+  size_t firsts[SPCONFIG_FIXEDMEMORY_MAXFITS];
+  size_t taken = 0;
+  while ((taken < count) && (taken < SPCONFIG_FIXEDMEMORY_MAXFITS))
+  {
+    firsts[taken] = findRun(blocksFor(sizes[taken]));
+    if (firsts[taken] >= m_blockCount)
+    {
+      break;
+    }
+    markBlocks(firsts[taken], blocksFor(sizes[taken]), true);
+    taken++;
+  }
+  for (size_t i = 0; i < taken; i++)
+  {
+    markBlocks(firsts[i], blocksFor(sizes[i]), false);
+  }
+  if (taken < count)
+  {
+    m_failures++;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief hold back allocations by other threads, e.g. from fits() to the allocations checked, 
+ *        the same thread may still allocate and lock again
+ * 
+ */
+void spConfigFixedMemory::lock()
+{
+  m_mutex.lock();
+}
+
+/**
+ * @brief end lock()
+ * 
+ */
+void spConfigFixedMemory::unlock()
+{
+  m_mutex.unlock();
+}
+
+
+
+/*    PRIVATE    PRIVATE    PRIVATE    PRIVATE
+
+      xxxxxxx   xxxxxxx      xx     xx    xx     xx     xxxxxxxx  xxxxxxxx
+      xx    xx  xx    xx     xx     xx    xx    xxxx       xx     xx      
+      xx    xx  xx    xx     xx     xx    xx   xx  xx      xx     xx      
+      xxxxxxx   xxxxxxx      xx      xx  xx   xx    xx     xx     xxxxxxx    
+      xx        xx    xx     xx      xx  xx   xxxxxxxx     xx     xx    
+      xx        xx    xx     xx       xxxx    xx    xx     xx     xx      
+      xx        xx    xx     xx        xx     xx    xx     xx     xxxxxxxx
+     
+
+      PRIVATE    PRIVATE    PRIVATE    PRIVATE    */
+
+
+/**
+ * @brief take the first run of free blocks large enough for the bytes requested
+ *        callers check with fits() beforehand, so running out of blocks here is an error, which is 
+ *        logged and reported as std::bad_alloc, as required for a memory resource, or aborts the 
+ *        program, when compiled without exceptions
+ * 
+ * @param bytes  number of bytes
+ * @param alignment  alignment, up to SPCONFIG_FIXEDMEMORY_BLOCKSIZE
+ * @return void*  memory
+ */
+void* spConfigFixedMemory::do_allocate(size_t bytes, size_t alignment)
+{
+  size_t count = blocksFor(bytes);
+  {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    size_t first = (alignment <= SPCONFIG_FIXEDMEMORY_BLOCKSIZE) ? findRun(count) : m_blockCount;
+    if (first < m_blockCount)
+    {
+      markBlocks(first, count, true);
+      if (first == m_firstFree)
+      {
+        m_firstFree = first + count;
+      }
+      m_usedBlocks += count;
+      if (m_usedBlocks > m_peakBlocks)
+      {
+        m_peakBlocks = m_usedBlocks;
+      }
+      return m_pBlocks + first * SPCONFIG_FIXEDMEMORY_BLOCKSIZE;
+    }
+    m_failures++;
+  }
+  spLOGF_E("spConfigFixedMemory could not allocate %u bytes, %u of %u bytes used", (unsigned int)bytes, (unsigned int)used(), (unsigned int)capacity());
+#ifdef SPCONFIG_EXCEPTIONS
+  throw std::bad_alloc();
+#else
+  abort();
+#endif
+}
+
+/**
+ * @brief return the blocks of memory obtained by do_allocate()
+ * 
+ * @param p  memory
+ * @param bytes  number of bytes as requested
+ */
+void spConfigFixedMemory::do_deallocate(void* p, size_t bytes, size_t)
+{
+  if (p == nullptr)
+  {
+    return;
+  }
+  size_t count = blocksFor(bytes);
+  size_t first = ((char*)p - m_pBlocks) / SPCONFIG_FIXEDMEMORY_BLOCKSIZE;
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  markBlocks(first, count, false);
+  m_usedBlocks -= count;
+  if (first < m_firstFree)
+  {
+    m_firstFree = first;
+  }
+}
+
+/**
+ * @brief memory can only be returned to the object it was obtained from
+ * 
+ * @param other 
+ * @return true / false 
+ */
+bool spConfigFixedMemory::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+  return (this == &other);
+}
+
+/**
+ * @brief returns whether a block is in use
+ * 
+ * @param block  index of block
+ * @return true / false 
+ */
+bool spConfigFixedMemory::isUsed(size_t block) const
+{
+  return (m_pUsed[block / 8] & (1 << (block % 8))) != 0;
+}
+
+/**
+ * @brief mark a run of blocks as used or free
+ * 
+ * @param first  index of first block
+ * @param count  number of blocks
+ * @param used  true for used, false for free
+ */
+void spConfigFixedMemory::markBlocks(size_t first, size_t count, bool used)
+{
+  for (size_t block = first; block < first + count; block++)
+  {
+    if (used)
+    {
+      m_pUsed[block / 8] |= (uint8_t)(1 << (block % 8));
+    }
+    else
+    {
+      m_pUsed[block / 8] &= (uint8_t)~(1 << (block % 8));
+    }
+  }
+}
+
+/**
+ * @brief return the first run of free blocks of the length given
+ * 
+ * @param count  number of blocks
+ * @return size_t  index of first block or the number of blocks, if no run is free
+ */
+size_t spConfigFixedMemory::findRun(size_t count) const
+{
+  size_t run = 0;
+  for (size_t block = m_firstFree; block < m_blockCount; block++)
+  {
+    run = isUsed(block) ? 0 : run + 1;
+    if (run == count)
+    {
+      return block + 1 - count;
+    }
+  }
+  return m_blockCount;
+}
+
+/**
+ * @brief return the number of blocks holding the bytes given, at least one
+ * 
+ * @param bytes  number of bytes
+ * @return size_t 
+ */
+size_t spConfigFixedMemory::blocksFor(size_t bytes)
+{
+  size_t count = (bytes + SPCONFIG_FIXEDMEMORY_BLOCKSIZE - 1) / SPCONFIG_FIXEDMEMORY_BLOCKSIZE;
+  return (count == 0) ? 1 : count;
+}
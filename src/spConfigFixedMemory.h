@@ -0,0 +1,78 @@
+/**
+ * @file spConfigFixedMemory.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to provide memory from caller-provided static storage
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version for the fixed-memory mode of spConfigBase
+ * 
+ */
+
+
+#ifndef SPCONFIGFIXEDMEMORY_H
+#define SPCONFIGFIXEDMEMORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <new>
+#include <mutex>
+#include <memory_resource>
+
+#include <spLogHelper.h>
+
+
+// size of the blocks memory is handed out in, must be a power of 2 and at least the largest alignment needed
+#ifndef SPCONFIG_FIXEDMEMORY_BLOCKSIZE
+  #define SPCONFIG_FIXEDMEMORY_BLOCKSIZE  16
+#endif
+
+// maximum number of allocations checked at once by fits()
+#ifndef SPCONFIG_FIXEDMEMORY_MAXFITS
+  #define SPCONFIG_FIXEDMEMORY_MAXFITS  16
+#endif
+
+
+class spConfigFixedMemory : public std::pmr::memory_resource
+{
+  private:
+    // guards all, as the memory may be shared by several config objects, and is held by callers 
+    // from fits() to the allocations checked
+    mutable std::recursive_mutex m_mutex;
+    // one bit per block for blocks in use, kept in front of the blocks
+    uint8_t* m_pUsed = nullptr;
+    char* m_pBlocks = nullptr;
+    size_t m_blockCount = 0;
+    size_t m_firstFree = 0; // no free block below
+    size_t m_usedBlocks = 0;
+    size_t m_peakBlocks = 0;
+    size_t m_failures = 0;
+    //
+    bool isUsed(size_t block) const;
+    void markBlocks(size_t first, size_t count, bool used);
+    size_t findRun(size_t count) const;
+    static size_t blocksFor(size_t bytes);
+
+  protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+  public:
+    spConfigFixedMemory(void* buffer, size_t size);
+    spConfigFixedMemory(const spConfigFixedMemory &memory) = delete;
+    spConfigFixedMemory& operator =(const spConfigFixedMemory &memory) = delete;
+    size_t capacity() const;
+    size_t used() const;
+    size_t peak() const;
+    size_t failures() const;
+    bool fits(const size_t* sizes, size_t count);
+    void lock();
+    void unlock();
+
+};
+
+#endif // SPCONFIGFIXEDMEMORY_H
@@ -0,0 +1,245 @@
+/**
+ * @file spConfigFrozen.cpp
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to hold a read-only table of config values with a minimal perfect hash
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <spConfigFrozen.h>
+#include <map>
+#include <algorithm>
+
+
+// average number of entries per bucket sharing a seed
+#define SPCONFIG_FROZEN_BUCKETSIZE  2
+
+
+/*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
+
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx      xxxxxx 
+      xx    xx  xx    xx  xx    xx  xx           xx     xx    xx
+      xx    xx  xx    xx  xx    xx  xx           xx     xx      
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx    xx
+      xx         xxxxxx   xxxxxxx   xxxxxxxx     xx      xxxxxx 
+     
+
+      PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
+
+
+spConfigFrozen::spConfigFrozen()
+{
+}
+
+/**
+ * @brief build the table from the values of all layers, taking the value of the first layer with
+ *        section and key, and find a seed for each bucket of hashes, so every entry has its own slot
+ * 
+ * @param layers  stores in order of precedence, nullptr for layers not used
+ * @return true / false  for success, fails only for different names with the same 64 bit hash
+ */
+bool spConfigFrozen::build(std::initializer_list<const spConfigStore*> layers)
+{
+  // merge layers, lowest precedence first so others replace its values
+  std::map<std::pair<std::string, std::string>, const spConfigValue*> values;
+  for (auto it = std::rbegin(layers); it != std::rend(layers); it++)
+  {
+    if (*it == nullptr)
+    {
+      continue;
+    }
+    (*it)->forEach([&values](const char* section, const char* key, const spConfigValue &cv) {
+      values[std::make_pair(std::string(section), std::string(key))] = &cv;
+      return true;
+    });
+  }
+
+  size_t count = values.size();
+  std::vector<uint64_t> hashes;
+  hashes.reserve(count);
+  size_t namesLen = 0;
+  size_t textsLen = 0;
+  for (auto &entry : values)
+  {
+    const std::string &section = entry.first.first;
+    const std::string &key = entry.first.second;
+    hashes.push_back(spConfigKey(section.c_str(), section.length(), key.c_str(), key.length()).hash());
+    namesLen += section.length() + key.length();
+    textsLen += strlen(entry.second->c_str() ? entry.second->c_str() : "") + 1;
+  }
+  std::vector<uint64_t> sortedHashes(hashes);
+  std::sort(sortedHashes.begin(), sortedHashes.end());
+  if (std::adjacent_find(sortedHashes.begin(), sortedHashes.end()) != sortedHashes.end())
+  {
+    spLOG_E("spConfigFrozen::build() failed, as different keys have the same hash");
+    return false;
+  }
+
+  // group entries into buckets and place the largest buckets first, while most slots are free
+  size_t bucketCount = count / SPCONFIG_FROZEN_BUCKETSIZE + 1;
+  std::vector<std::vector<size_t>> buckets(bucketCount);
+  for (size_t i = 0; i < count; i++)
+  {
+    buckets[hashes[i] % bucketCount].push_back(i);
+  }
+  std::vector<size_t> order(bucketCount);
+  for (size_t b = 0; b < bucketCount; b++)
+  {
+    order[b] = b;
+  }
+  std::stable_sort(order.begin(), order.end(), [&buckets](size_t b1, size_t b2) {
+    return buckets[b1].size() > buckets[b2].size();
+  });
+
+  std::vector<uint32_t> seeds(bucketCount, 0);
+  std::vector<size_t> slotEntry(count, count);
+  std::vector<size_t> positions;
+  uint64_t maxSeed = (uint64_t)count * 16 + 1024;
+  for (size_t b : order)
+  {
+    const std::vector<size_t> &bucket = buckets[b];
+    if (bucket.empty())
+    {
+      break;
+    }
+    bool placed = false;
+    for (uint32_t seed = 1; seed < maxSeed; seed++)
+    {
+      positions.clear();
+      for (size_t i : bucket)
+      {
+        size_t pos = mix(hashes[i], seed) % count;
+        if ((slotEntry[pos] != count) || (std::find(positions.begin(), positions.end(), pos) != positions.end()))
+        {
+          break;
+        }
+        positions.push_back(pos);
+      }
+      if (positions.size() == bucket.size())
+      {
+        for (size_t j = 0; j < bucket.size(); j++)
+        {
+          slotEntry[positions[j]] = bucket[j];
+        }
+        seeds[b] = seed;
+        placed = true;
+        break;
+      }
+    }
+    if (!placed)
+    {
+      spLOG_E("spConfigFrozen::build() failed to find a seed for a bucket");
+      return false;
+    }
+  }
+
+  // lay out slots, names and value texts, the texts buffer is never resized, so the values can borrow from it
+  std::vector<const std::pair<const std::pair<std::string, std::string>, const spConfigValue*>*> entries;
+  entries.reserve(count);
+  for (auto &entry : values)
+  {
+    entries.push_back(&entry);
+  }
+  std::vector<Slot> slots(count);
+  std::vector<char> names;
+  names.reserve(namesLen);
+  std::vector<char> texts(textsLen);
+  size_t textPos = 0;
+  for (size_t pos = 0; pos < count; pos++)
+  {
+    size_t i = slotEntry[pos];
+    const std::string &section = entries[i]->first.first;
+    const std::string &key = entries[i]->first.second;
+    Slot &slot = slots[pos];
+    slot.hash = hashes[i];
+    slot.sectionPos = (uint32_t)names.size();
+    slot.sectionLen = (uint32_t)section.length();
+    names.insert(names.end(), section.begin(), section.end());
+    slot.keyPos = (uint32_t)names.size();
+    slot.keyLen = (uint32_t)key.length();
+    names.insert(names.end(), key.begin(), key.end());
+    const char* text = entries[i]->second->c_str() ? entries[i]->second->c_str() : "";
+    size_t len = strlen(text);
+    memcpy(texts.data() + textPos, text, len + 1);
+    slot.value.borrow(texts.data() + textPos, len);
+    textPos += len + 1;
+  }
+
+  m_seeds.swap(seeds);
+  m_slots.swap(slots);
+  m_names.swap(names);
+  // swapping keeps the memory borrowed by the slots' values
+  m_texts.swap(texts);
+  return true;
+}
+
+/**
+ * @brief return the value for section and key with a single probe
+ * 
+ * @param key  section and key with hash
+ * @return spConfigValue*  pointer to value or nullptr if not found
+ */
+spConfigValue* spConfigFrozen::find(const spConfigKey &key) const
+{
+  if (m_slots.empty())
+  {
+    return nullptr;
+  }
+  uint64_t hash = key.hash();
+  uint32_t seed = m_seeds[hash % m_seeds.size()];
+  const Slot &slot = m_slots[mix(hash, seed) % m_slots.size()];
+  if ((slot.hash == hash) &&
+      (slot.sectionLen == key.sectionLength()) &&
+      (slot.keyLen == key.keyLength()) &&
+      (memcmp(m_names.data() + slot.sectionPos, key.section(), key.sectionLength()) == 0) &&
+      (memcmp(m_names.data() + slot.keyPos, key.key(), key.keyLength()) == 0))
+  {
+    return const_cast<spConfigValue*>(&slot.value);
+  }
+  return nullptr;
+}
+
+/**
+ * @brief return number of values in table
+ * 
+ * @return size_t
+ */
+size_t spConfigFrozen::count() const
+{
+  return m_slots.size();
+}
+
+
+
+/*    PRIVATE    PRIVATE    PRIVATE    PRIVATE
+
+      xxxxxxx   xxxxxxx      xx     xx    xx     xx     xxxxxxxx  xxxxxxxx
+      xx    xx  xx    xx     xx     xx    xx    xxxx       xx     xx      
+      xx    xx  xx    xx     xx     xx    xx   xx  xx      xx     xx      
+      xxxxxxx   xxxxxxx      xx      xx  xx   xx    xx     xx     xxxxxxx    
+      xx        xx    xx     xx      xx  xx   xxxxxxxx     xx     xx    
+      xx        xx    xx     xx       xxxx    xx    xx     xx     xx      
+      xx        xx    xx     xx        xx     xx    xx     xx     xxxxxxxx
+     
+
+      PRIVATE    PRIVATE    PRIVATE    PRIVATE    */
+
+
+/**
+ * @brief derive the slot position of a hash for a bucket's seed (splitmix64 finalizer)
+ * 
+ * @param hash  hash of section and key
+ * @param seed  seed of bucket
+ * @return uint64_t  mixed hash
+ */
+uint64_t spConfigFrozen::mix(uint64_t hash, uint32_t seed)
+{
+  uint64_t x = hash + seed * 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
@@ -0,0 +1,61 @@
+/**
+ * @file spConfigFrozen.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to hold a read-only table of config values with a minimal perfect hash
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version for freezing spConfigBase objects
+ * 
+ */
+
+
+#ifndef SPCONFIGFROZEN_H
+#define SPCONFIGFROZEN_H
+
+#include <stdint.h>
+#include <string>
+#include <string.h>
+#include <vector>
+#include <initializer_list>
+
+#include <spConfigKey.h>
+#include <spConfigValue.h>
+#include <spConfigStore.h>
+
+
+class spConfigFrozen
+{
+  private:
+    struct Slot
+    {
+      uint64_t hash;
+      uint32_t sectionPos;
+      uint32_t sectionLen;
+      uint32_t keyPos;
+      uint32_t keyLen;
+      spConfigValue value { (const char*)nullptr }; // no buffer of its own, until it borrows its text
+    };
+    // seed per bucket of hashes, which places all entries of the bucket in free slots
+    std::vector<uint32_t> m_seeds;
+    // one slot per entry, with section and key names kept next to each other in one buffer
+    // and the zero terminated value texts in another one, borrowed by the slots' values
+    std::vector<Slot> m_slots;
+    std::vector<char> m_names;
+    std::vector<char> m_texts;
+    //
+    static uint64_t mix(uint64_t hash, uint32_t seed);
+
+  public:
+    spConfigFrozen();
+    spConfigFrozen(const spConfigFrozen &frozen) = delete;
+    spConfigFrozen& operator =(const spConfigFrozen &frozen) = delete;
+    bool build(std::initializer_list<const spConfigStore*> layers);
+    spConfigValue* find(const spConfigKey &key) const;
+    size_t count() const;
+
+};
+
+#endif // SPCONFIGFROZEN_H
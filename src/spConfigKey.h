@@ -0,0 +1,95 @@
+/**
+ * @file spConfigKey.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to hold section and key names with their hash
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version for hashed lookups
+ * 
+ */
+
+
+#ifndef SPCONFIGKEY_H
+#define SPCONFIGKEY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+class spConfigKey
+{
+  private:
+    const char* m_section;
+    const char* m_key;
+    size_t m_sectionLen;
+    size_t m_keyLen;
+    uint64_t m_hash;
+
+    static constexpr size_t length(const char* str)
+    {
+      size_t len = 0;
+      while (str[len] != 0)
+      {
+        len++;
+      }
+      return len;
+    }
+
+    // FNV-1a over section, a separator and key
+    static constexpr uint64_t hashOf(const char* section, size_t sectionLen, const char* key, size_t keyLen)
+    {
+      uint64_t hash = 14695981039346656037ULL;
+      for (size_t i = 0; i < sectionLen; i++)
+      {
+        hash = (hash ^ (uint8_t)section[i]) * 1099511628211ULL;
+      }
+      hash = (hash ^ 0xff) * 1099511628211ULL;
+      for (size_t i = 0; i < keyLen; i++)
+      {
+        hash = (hash ^ (uint8_t)key[i]) * 1099511628211ULL;
+      }
+      return hash;
+    }
+
+  public:
+    /**
+     * @brief construct key from section and key names, which must remain valid while the key is used
+     *        use SPCONFIG_KEY() to have this done at compile time for string literals
+     * 
+     * @param section   name of section 
+     * @param key       name of key
+     */
+    constexpr spConfigKey(const char* section, const char* key) :
+      m_section(section ? section : ""), m_key(key ? key : ""),
+      m_sectionLen(length(section ? section : "")), m_keyLen(length(key ? key : "")),
+      m_hash(hashOf(section ? section : "", length(section ? section : ""), key ? key : "", length(key ? key : "")))
+    {
+    }
+
+    /**
+     * @brief construct key from section and key names with known lengths
+     * 
+     */
+    constexpr spConfigKey(const char* section, size_t sectionLen, const char* key, size_t keyLen) :
+      m_section(section), m_key(key), m_sectionLen(sectionLen), m_keyLen(keyLen),
+      m_hash(hashOf(section, sectionLen, key, keyLen))
+    {
+    }
+
+    constexpr const char* section() const { return m_section; }
+    constexpr const char* key() const { return m_key; }
+    constexpr size_t sectionLength() const { return m_sectionLen; }
+    constexpr size_t keyLength() const { return m_keyLen; }
+    constexpr uint64_t hash() const { return m_hash; }
+
+};
+
+// key for string literals with hash computed at compile time, e.g. SPCONFIG_KEY("system", "startCounterToday")
+#define SPCONFIG_KEY(section, key) ([]() { constexpr spConfigKey spConfigKeyLiteral(section, key); return spConfigKeyLiteral; }())
+
+#endif // SPCONFIGKEY_H
+
+
@@ -0,0 +1,224 @@
+/**
+ * @file spConfigMetrics.cpp
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief classes to count lookups, sets, reads and saves of a config object
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <spConfigMetrics.h>
+#include <stdio.h>
+
+
+/*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
+
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx      xxxxxx 
+      xx    xx  xx    xx  xx    xx  xx           xx     xx    xx
+      xx    xx  xx    xx  xx    xx  xx           xx     xx      
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx    xx
+      xx         xxxxxx   xxxxxxx   xxxxxxxx     xx      xxxxxx 
+     
+
+      PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
+
+
+
+/**
+ * @brief return the sum of all shards
+ * 
+ * @return uint64_t 
+ */
+uint64_t spConfigCounter::value() const
+{
+  uint64_t sum = 0;
+  for (size_t i = 0; i < SPCONFIG_METRICS_SHARDS; i++)
+  {
+    sum += m_shards[i].value.load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+/**
+ * @brief set all shards to 0
+ * 
+ */
+void spConfigCounter::reset()
+{
+  for (size_t i = 0; i < SPCONFIG_METRICS_SHARDS; i++)
+  {
+    m_shards[i].value.store(0, std::memory_order_relaxed);
+  }
+}
+
+
+spConfigDurations::spConfigDurations()
+{
+  reset();
+}
+
+/**
+ * @brief count a duration in its bucket
+ * 
+ * @param us  duration in microseconds
+ */
+void spConfigDurations::record(uint64_t us)
+{
+  size_t bucket = 0;
+  while ((bucket < SPCONFIG_METRICS_BUCKETS) && (us > bucketBoundUS(bucket)))
+  {
+    bucket++;
+  }
+  m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_sumUS.fetch_add(us, std::memory_order_relaxed);
+}
+
+/**
+ * @brief copy counts and sum, which may be slightly inconsistent while durations are recorded
+ * 
+ * @param snapshot  copy of counts and sum
+ */
+void spConfigDurations::snapshot(spConfigDurationSnapshot &snapshot) const
+{
+  for (size_t i = 0; i <= SPCONFIG_METRICS_BUCKETS; i++)
+  {
+    snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+  }
+  snapshot.count = m_count.load(std::memory_order_relaxed);
+  snapshot.sumUS = m_sumUS.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief set counts and sum to 0
+ * 
+ */
+void spConfigDurations::reset()
+{
+  for (size_t i = 0; i <= SPCONFIG_METRICS_BUCKETS; i++)
+  {
+    m_buckets[i].store(0, std::memory_order_relaxed);
+  }
+  m_count.store(0, std::memory_order_relaxed);
+  m_sumUS.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief return the upper bound of a bucket, 100 us for the first and 10 times more for each following
+ * 
+ * @param bucket  number of bucket, less than SPCONFIG_METRICS_BUCKETS
+ * @return uint64_t  bound in microseconds
+ */
+uint64_t spConfigDurations::bucketBoundUS(size_t bucket)
+{
+  uint64_t bound = 100;
+  for (size_t i = 0; i < bucket; i++)
+  {
+    bound *= 10;
+  }
+  return bound;
+}
+
+
+/**
+ * @brief copy all counters
+ * 
+ * @param snapshot  copy of counters
+ */
+void spConfigMetrics::snapshot(spConfigMetricsSnapshot &snapshot) const
+{
+  snapshot.lookups = lookups.value();
+  snapshot.misses = misses.value();
+  snapshot.noopSets = noopSets.value();
+  snapshot.sets = stores.value() + snapshot.noopSets;
+  snapshot.readBytes = readBytes.load(std::memory_order_relaxed);
+  snapshot.saveBytes = saveBytes.load(std::memory_order_relaxed);
+  snapshot.saveFailures = saveFailures.load(std::memory_order_relaxed);
+  snapshot.autosaves = autosaves.load(std::memory_order_relaxed);
+  readTime.snapshot(snapshot.readTime);
+  saveTime.snapshot(snapshot.saveTime);
+}
+
+/**
+ * @brief set all counters to 0
+ * 
+ */
+void spConfigMetrics::reset()
+{
+  lookups.reset();
+  misses.reset();
+  stores.reset();
+  noopSets.reset();
+  readBytes.store(0, std::memory_order_relaxed);
+  saveBytes.store(0, std::memory_order_relaxed);
+  saveFailures.store(0, std::memory_order_relaxed);
+  autosaves.store(0, std::memory_order_relaxed);
+  readTime.reset();
+  saveTime.reset();
+}
+
+/**
+ * @brief return counters in the Prometheus text exposition format, e.g. to be served by an http endpoint
+ * 
+ * @param snapshot  counters, e.g. from spConfigBase::getMetrics()
+ * @param prefix  prefix of metric names
+ * @param labels  labels added to every metric, e.g. 'instance="main"', or "" for none
+ * @return std::string  text with '# HELP' and '# TYPE' lines for each metric
+ */
+std::string spConfigMetrics::toPrometheus(const spConfigMetricsSnapshot &snapshot, const char* prefix, const char* labels)
+{
+  std::string text;
+  char line[256];
+  bool hasLabels = (labels != nullptr) && (labels[0] != 0);
+  const char* sep = hasLabels ? "," : "";
+  if (!hasLabels)
+  {
+    labels = "";
+  }
+
+  auto counter = [&](const char* name, const char* help, uint64_t value) {
+    snprintf(line, sizeof(line), "# HELP %s_%s %s\n# TYPE %s_%s counter\n", prefix, name, help, prefix, name);
+    text.append(line);
+    snprintf(line, sizeof(line), hasLabels ? "%s_%s{%s} %llu\n" : "%s_%s%s %llu\n", prefix, name, labels, (unsigned long long)value);
+    text.append(line);
+  };
+  auto histogram = [&](const char* name, const char* help, const spConfigDurationSnapshot &durations) {
+    snprintf(line, sizeof(line), "# HELP %s_%s %s\n# TYPE %s_%s histogram\n", prefix, name, help, prefix, name);
+    text.append(line);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i <= SPCONFIG_METRICS_BUCKETS; i++)
+    {
+      cumulative += durations.buckets[i];
+      char le[32];
+      if (i < SPCONFIG_METRICS_BUCKETS)
+      {
+        snprintf(le, sizeof(le), "%g", spConfigDurations::bucketBoundUS(i) / 1000000.0);
+      }
+      else
+      {
+        snprintf(le, sizeof(le), "+Inf");
+      }
+      snprintf(line, sizeof(line), "%s_%s_bucket{%s%sle=\"%s\"} %llu\n", prefix, name, labels, sep, le, (unsigned long long)cumulative);
+      text.append(line);
+    }
+    snprintf(line, sizeof(line), hasLabels ? "%s_%s_sum{%s} %.6f\n" : "%s_%s_sum%s %.6f\n", prefix, name, labels, durations.sumUS / 1000000.0);
+    text.append(line);
+    snprintf(line, sizeof(line), hasLabels ? "%s_%s_count{%s} %llu\n" : "%s_%s_count%s %llu\n", prefix, name, labels, (unsigned long long)cumulative);
+    text.append(line);
+  };
+
+  counter("lookups_total", "Config values looked up.", snapshot.lookups);
+  counter("lookup_misses_total", "Lookups not finding a config value.", snapshot.misses);
+  counter("sets_total", "Calls of setValue().", snapshot.sets);
+  counter("noop_sets_total", "Calls of setValue() with the value already set.", snapshot.noopSets);
+  counter("read_bytes_total", "Bytes of configuration files parsed.", snapshot.readBytes);
+  counter("save_bytes_total", "Bytes of configuration files saved.", snapshot.saveBytes);
+  counter("save_failures_total", "Saves failing to write the configuration file.", snapshot.saveFailures);
+  counter("autosaves_total", "Saves started by autosave.", snapshot.autosaves);
+  histogram("read_duration_seconds", "Duration of parsing configuration files.", snapshot.readTime);
+  histogram("save_duration_seconds", "Duration of saving configuration files.", snapshot.saveTime);
+  return text;
+}
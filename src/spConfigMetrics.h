@@ -0,0 +1,128 @@
+/**
+ * @file spConfigMetrics.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief classes to count lookups, sets, reads and saves of a config object
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version
+ * 
+ */
+
+
+#ifndef SPCONFIGMETRICS_H
+#define SPCONFIGMETRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <atomic>
+
+
+// define SPCONFIG_NO_METRICS to remove all counting from spConfigBase, getMetrics() then returns zeros
+#ifndef SPCONFIG_NO_METRICS
+  #define SPCONFIG_METRIC(statement)  statement
+#else
+  #define SPCONFIG_METRIC(statement)
+#endif
+
+// counters of frequent events are split into shards, so threads counting at the same time rarely share
+// a cache line, use 1 to save memory on devices with few cores
+#ifndef SPCONFIG_METRICS_SHARDS
+  #define SPCONFIG_METRICS_SHARDS  8
+#endif
+
+// number of duration buckets with upper bounds of 100 us, 1 ms, 10 ms, 100 ms, 1 s and 10 s,
+// followed by one for all longer durations
+#define SPCONFIG_METRICS_BUCKETS  6
+
+
+// durations counted by bucket, not cumulative
+struct spConfigDurationSnapshot
+{
+  uint64_t buckets[SPCONFIG_METRICS_BUCKETS + 1] = {};
+  uint64_t count = 0;
+  uint64_t sumUS = 0;
+};
+
+struct spConfigMetricsSnapshot
+{
+  uint64_t lookups = 0;       // values looked up by getters
+  uint64_t misses = 0;        // lookups not finding a value
+  uint64_t sets = 0;          // calls of setValue()
+  uint64_t noopSets = 0;      // calls of setValue() with the value already set
+  uint64_t readBytes = 0;     // bytes of files parsed
+  uint64_t saveBytes = 0;     // bytes of files saved
+  uint64_t saveFailures = 0;  // saves failing to write the file
+  uint64_t autosaves = 0;     // saves started by autosave
+  spConfigDurationSnapshot readTime;  // durations of parsing files, the count is the number of files parsed
+  spConfigDurationSnapshot saveTime;  // durations of saving files, the count is the number of files saved
+};
+
+
+class spConfigCounter
+{
+  private:
+    struct alignas(64) Shard
+    {
+      std::atomic<uint64_t> value{0};
+    };
+    Shard m_shards[SPCONFIG_METRICS_SHARDS];
+    static size_t shardIndex()
+    {
+      static std::atomic<size_t> s_nextShard{0};
+      thread_local size_t t_shard = s_nextShard.fetch_add(1, std::memory_order_relaxed) % SPCONFIG_METRICS_SHARDS;
+      return t_shard;
+    }
+
+  public:
+    void add(uint64_t n = 1)
+    {
+      m_shards[shardIndex()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+    uint64_t value() const;
+    void reset();
+
+};
+
+
+class spConfigDurations
+{
+  private:
+    std::atomic<uint64_t> m_buckets[SPCONFIG_METRICS_BUCKETS + 1];
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sumUS{0};
+
+  public:
+    spConfigDurations();
+    void record(uint64_t us);
+    void snapshot(spConfigDurationSnapshot &snapshot) const;
+    void reset();
+    static uint64_t bucketBoundUS(size_t bucket);
+
+};
+
+
+class spConfigMetrics
+{
+  public:
+    spConfigCounter lookups;
+    spConfigCounter misses;
+    spConfigCounter stores;
+    spConfigCounter noopSets;
+    std::atomic<uint64_t> readBytes{0};
+    std::atomic<uint64_t> saveBytes{0};
+    std::atomic<uint64_t> saveFailures{0};
+    std::atomic<uint64_t> autosaves{0};
+    spConfigDurations readTime;
+    spConfigDurations saveTime;
+
+    void snapshot(spConfigMetricsSnapshot &snapshot) const;
+    void reset();
+    static std::string toPrometheus(const spConfigMetricsSnapshot &snapshot, const char* prefix = "spconfig", const char* labels = "");
+
+};
+
+#endif // SPCONFIGMETRICS_H
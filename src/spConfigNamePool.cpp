@@ -0,0 +1,294 @@
+/**
+ * @file spConfigNamePool.cpp
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to hold each distinct section and key name once
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <spConfigNamePool.h>
+
+
+// initial number of hash slots, must be a power of 2
+#define SPCONFIG_NAMEPOOL_MINSLOTS  64
+
+
+/*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
+
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx      xxxxxx 
+      xx    xx  xx    xx  xx    xx  xx           xx     xx    xx
+      xx    xx  xx    xx  xx    xx  xx           xx     xx      
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx    xx
+      xx         xxxxxx   xxxxxxx   xxxxxxxx     xx      xxxxxx 
+     
+
+      PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
+
+
+/**
+ * @brief Construct a new name pool, taking memory for names and index from the memory resource given
+ * 
+ * @param pResource  memory resource or nullptr for new / delete
+ */
+spConfigNamePool::spConfigNamePool(std::pmr::memory_resource* pResource) : 
+    m_pResource(pResource ? pResource : std::pmr::new_delete_resource()),
+    m_chunks(m_pResource), m_slots(SPCONFIG_NAMEPOOL_MINSLOTS, nullptr, m_pResource)
+{
+}
+
+spConfigNamePool::~spConfigNamePool()
+{
+  for (Chunk &chunk : m_chunks)
+  {
+    m_pResource->deallocate(chunk.pData, chunk.size, 1);
+  }
+}
+
+/**
+ * @brief return the pooled copy of a name, which is added on first use and remains valid 
+ *        as long as the pool, so equal names from the same pool have the same pointer
+ * 
+ * @param name  name, does not need to be null terminated
+ * @param len  length of name
+ * @return const char*  null terminated name in pool
+ */
+const char* spConfigNamePool::intern(const char* name, size_t len)
+{
+  uint64_t hash = hashOf(name, len);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  size_t idx;
+  const char* found = lookup(name, len, hash, idx);
+  if (found)
+  {
+    return found;
+  }
+
+  char* pooled = allocate(len + 1);
+  memcpy(pooled, name, len);
+  pooled[len] = 0;
+  m_slots[idx] = pooled;
+  m_count++;
+  // keep load factor at or below 0.5
+  if (m_count * 2 > m_slots.size())
+  {
+    grow();
+  }
+  return pooled;
+}
+
+/**
+ * @brief return the sizes of the allocations interning two names would make, e.g. to check them with 
+ *        spConfigFixedMemory::fits() before, as intern() cannot fail
+ * 
+ * @param name1  first name, does not need to be null terminated
+ * @param len1  length of first name
+ * @param name2  second name, interned after the first
+ * @param len2  length of second name
+ * @param sizes  array of at least 6 elements receiving the number of bytes of each allocation
+ * @return size_t  number of allocations
+ */
+size_t spConfigNamePool::allocationsFor(const char* name1, size_t len1, const char* name2, size_t len2, size_t* sizes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  size_t allocations = 0;
+  bool hasChunk = (m_pChunk != nullptr);
+  size_t chunkUsed = m_chunkUsed;
+  size_t chunks = m_chunks.size();
+  size_t count = m_count;
+  size_t slots = m_slots.size();
+  size_t idx;
+  for (int i = 0; i < 2; i++)
+  {
+    const char* name = (i == 0) ? name1 : name2;
+    size_t len = (i == 0) ? len1 : len2;
+    if (lookup(name, len, hashOf(name, len), idx) || ((i == 1) && (len1 == len2) && (strncmp(name1, name2, len) == 0)))
+    {
+      continue;
+    }
+    // following allocate(), addChunk() and grow()
+    size_t chunkSize = 0;
+    if (len + 1 > SPCONFIG_NAMEPOOL_CHUNKSIZE)
+    {
+      chunkSize = len + 1;
+    }
+    else if (!hasChunk || (chunkUsed + len + 1 > SPCONFIG_NAMEPOOL_CHUNKSIZE))
+    {
+      chunkSize = SPCONFIG_NAMEPOOL_CHUNKSIZE;
+      hasChunk = true;
+      chunkUsed = 0;
+    }
+    if (chunkSize > 0)
+    {
+      chunks++;
+      sizes[allocations++] = chunks * sizeof(Chunk);
+      sizes[allocations++] = chunkSize;
+    }
+    if (len + 1 <= SPCONFIG_NAMEPOOL_CHUNKSIZE)
+    {
+      chunkUsed += len + 1;
+    }
+    count++;
+    if (count * 2 > slots)
+    {
+      slots *= 2;
+      sizes[allocations++] = slots * sizeof(const char*);
+    }
+  }
+  return allocations;
+}
+
+/**
+ * @brief return the bytes of the hash table a new pool takes from its memory resource
+ * 
+ * @return size_t 
+ */
+size_t spConfigNamePool::indexBytes()
+{
+  return SPCONFIG_NAMEPOOL_MINSLOTS * sizeof(const char*);
+}
+
+/**
+ * @brief return number of names in pool
+ * 
+ * @return size_t 
+ */
+size_t spConfigNamePool::count()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_count;
+}
+
+/**
+ * @brief return number of bytes allocated for names
+ * 
+ * @return size_t 
+ */
+size_t spConfigNamePool::bytes()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_bytes;
+}
+
+
+
+/*    PRIVATE    PRIVATE    PRIVATE    PRIVATE
+
+      xxxxxxx   xxxxxxx      xx     xx    xx     xx     xxxxxxxx  xxxxxxxx
+      xx    xx  xx    xx     xx     xx    xx    xxxx       xx     xx      
+      xx    xx  xx    xx     xx     xx    xx   xx  xx      xx     xx      
+      xxxxxxx   xxxxxxx      xx      xx  xx   xx    xx     xx     xxxxxxx    
+      xx        xx    xx     xx      xx  xx   xxxxxxxx     xx     xx    
+      xx        xx    xx     xx       xxxx    xx    xx     xx     xx      
+      xx        xx    xx     xx        xx     xx    xx     xx     xxxxxxxx
+     
+
+      PRIVATE    PRIVATE    PRIVATE    PRIVATE    */
+
+
+/**
+ * @brief FNV-1a hash of a name
+ * 
+ * @param name 
+ * @param len 
+ * @return uint64_t 
+ */
+uint64_t spConfigNamePool::hashOf(const char* name, size_t len)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < len; i++)
+  {
+    hash = (hash ^ (uint8_t)name[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * @brief probe the hash table for a name, called with pool guarded
+ * 
+ * @param name  name, does not need to be null terminated
+ * @param len  length of name
+ * @param hash  hash of name
+ * @param idx  index of slot with name or of the free slot ending the probe
+ * @return const char*  pooled name or nullptr if not found
+ */
+const char* spConfigNamePool::lookup(const char* name, size_t len, uint64_t hash, size_t &idx) const
+{
+  size_t mask = m_slots.size() - 1;
+  idx = hash & mask;
+  while (m_slots[idx] != nullptr)
+  {
+    const char* pooled = m_slots[idx];
+    if ((strncmp(pooled, name, len) == 0) && (pooled[len] == 0))
+    {
+      return pooled;
+    }
+    idx = (idx + 1) & mask;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief take memory from the current chunk or start a new one, names longer than a chunk get their own
+ * 
+ * @param size  number of bytes
+ * @return char*  memory for name
+ */
+char* spConfigNamePool::allocate(size_t size)
+{
+  if (size > SPCONFIG_NAMEPOOL_CHUNKSIZE)
+  {
+    return addChunk(size);
+  }
+  if ((m_pChunk == nullptr) || (m_chunkUsed + size > SPCONFIG_NAMEPOOL_CHUNKSIZE))
+  {
+    m_pChunk = addChunk(SPCONFIG_NAMEPOOL_CHUNKSIZE);
+    m_chunkUsed = 0;
+  }
+  char* ret = m_pChunk + m_chunkUsed;
+  m_chunkUsed += size;
+  return ret;
+}
+
+/**
+ * @brief take a new chunk from the memory resource
+ * 
+ * @param size  number of bytes
+ * @return char*  memory of chunk
+ */
+char* spConfigNamePool::addChunk(size_t size)
+{
+  m_chunks.reserve(m_chunks.size() + 1);
+  char* pData = static_cast<char*>(m_pResource->allocate(size, 1));
+  m_chunks.push_back(Chunk{ pData, size });
+  m_bytes += size;
+  return pData;
+}
+
+/**
+ * @brief double the number of hash slots and re-insert all names
+ * 
+ */
+void spConfigNamePool::grow()
+{
+  std::pmr::vector<const char*> oldSlots(m_slots.size() * 2, nullptr, m_pResource);
+  oldSlots.swap(m_slots);
+  size_t mask = m_slots.size() - 1;
+  for (const char* pooled : oldSlots)
+  {
+    if (pooled == nullptr)
+    {
+      continue;
+    }
+    size_t idx = hashOf(pooled, strlen(pooled)) & mask;
+    while (m_slots[idx] != nullptr)
+    {
+      idx = (idx + 1) & mask;
+    }
+    m_slots[idx] = pooled;
+  }
+}
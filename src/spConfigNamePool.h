@@ -0,0 +1,74 @@
+/**
+ * @file spConfigNamePool.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to hold each distinct section and key name once
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version for interning names of spConfigStore entries
+ *          optional memory resource for chunks and index
+ * 
+ */
+
+
+#ifndef SPCONFIGNAMEPOOL_H
+#define SPCONFIGNAMEPOOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+
+
+#ifndef SPCONFIG_NAMEPOOL_CHUNKSIZE
+  #define SPCONFIG_NAMEPOOL_CHUNKSIZE  1024
+#endif
+
+
+class spConfigNamePool
+{
+  private:
+    struct Chunk
+    {
+      char* pData;
+      size_t size;
+    };
+    std::mutex m_mutex; // guards all, as a pool may be shared by stores of different config objects
+    std::pmr::memory_resource* m_pResource;
+    // names are kept null terminated in chunks, which are never moved or freed before the pool
+    std::pmr::vector<Chunk> m_chunks;
+    char* m_pChunk = nullptr; // chunk currently filled
+    size_t m_chunkUsed = 0;
+    size_t m_bytes = 0;
+    // open addressing hash table with linear probing, pointing to names
+    std::pmr::vector<const char*> m_slots;
+    size_t m_count = 0;
+    //
+    static uint64_t hashOf(const char* name, size_t len);
+    const char* lookup(const char* name, size_t len, uint64_t hash, size_t &idx) const;
+    char* allocate(size_t size);
+    char* addChunk(size_t size);
+    void grow();
+
+  public:
+    spConfigNamePool(std::pmr::memory_resource* pResource = nullptr);
+    ~spConfigNamePool();
+    spConfigNamePool(const spConfigNamePool &pool) = delete;
+    spConfigNamePool& operator =(const spConfigNamePool &pool) = delete;
+    const char* intern(const char* name, size_t len);
+    size_t allocationsFor(const char* name1, size_t len1, const char* name2, size_t len2, size_t* sizes);
+    static size_t indexBytes();
+    size_t count();
+    size_t bytes();
+
+};
+
+// reference counted handle to share one pool between stores and config objects
+typedef std::shared_ptr<spConfigNamePool> spConfigNamePoolPtr;
+
+#endif // SPCONFIGNAMEPOOL_H
@@ -0,0 +1,289 @@
+/**
+ * @file spConfigNotifier.cpp
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to manage subscriptions to configuration changes
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <spConfigNotifier.h>
+
+
+// kinds of subscriptions held in m_subscriptionIndex
+#define SPCONFIG_SUBSCRIPTION_KEY     0
+#define SPCONFIG_SUBSCRIPTION_SECTION 1
+#define SPCONFIG_SUBSCRIPTION_GLOBAL  2
+
+
+/*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
+
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx      xxxxxx 
+      xx    xx  xx    xx  xx    xx  xx           xx     xx    xx
+      xx    xx  xx    xx  xx    xx  xx           xx     xx      
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx    xx
+      xx         xxxxxx   xxxxxxx   xxxxxxxx     xx      xxxxxx 
+     
+
+      PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
+
+
+/**
+ * @brief register a callback for changes of a single key, a whole section or everything
+ * 
+ * @param section   name of section or nullptr / "" for all sections
+ * @param key       name of key or nullptr / "" for all keys in section
+ * @param callback  function to call after a change
+ * @return uint32_t  subscription ID to be used with unsubscribe()
+ */
+uint32_t spConfigNotifier::subscribe(const char* section, const char* key, spConfigChangeCallback callback)
+{
+  if (!callback)
+  {
+    spLOG_E("spConfigNotifier::subscribe() called without callback");
+    return 0;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Subscription sub = { ++m_lastId, callback };
+  if ((section == nullptr) || (section[0] == 0))
+  {
+    m_globalSubscriptions.push_back(sub);
+    m_subscriptionIndex[sub.id] = std::make_pair(SPCONFIG_SUBSCRIPTION_GLOBAL, (uint64_t)0);
+  }
+  else if ((key == nullptr) || (key[0] == 0))
+  {
+    uint64_t hash = spConfigKey(section, "").hash();
+    m_sectionSubscriptions[hash].push_back({ section, "", sub });
+    m_subscriptionIndex[sub.id] = std::make_pair(SPCONFIG_SUBSCRIPTION_SECTION, hash);
+  }
+  else
+  {
+    uint64_t hash = spConfigKey(section, key).hash();
+    m_keySubscriptions[hash].push_back({ section, key, sub });
+    m_subscriptionIndex[sub.id] = std::make_pair(SPCONFIG_SUBSCRIPTION_KEY, hash);
+  }
+  m_subscriptionCount++;
+  return sub.id;
+}
+
+/**
+ * @brief remove a subscription
+ * 
+ * @param subscriptionId  ID as returned by subscribe()
+ * @return true / false  for subscription found and removed
+ */
+bool spConfigNotifier::unsubscribe(uint32_t subscriptionId)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto indexIt = m_subscriptionIndex.find(subscriptionId);
+  if (indexIt == m_subscriptionIndex.end())
+  {
+    return false;
+  }
+
+  if (indexIt->second.first == SPCONFIG_SUBSCRIPTION_GLOBAL)
+  {
+    for (auto it = m_globalSubscriptions.begin(); it != m_globalSubscriptions.end(); it++)
+    {
+      if (it->id == subscriptionId)
+      {
+        m_globalSubscriptions.erase(it);
+        break;
+      }
+    }
+  }
+  else
+  {
+    std::unordered_map<uint64_t, std::vector<NamedSubscription>> &subscriptions = 
+      (indexIt->second.first == SPCONFIG_SUBSCRIPTION_KEY) ? m_keySubscriptions : m_sectionSubscriptions;
+    std::vector<NamedSubscription> &subs = subscriptions[indexIt->second.second];
+    for (auto it = subs.begin(); it != subs.end(); it++)
+    {
+      if (it->sub.id == subscriptionId)
+      {
+        subs.erase(it);
+        break;
+      }
+    }
+    // drop empty lists, so they are not visited on changes
+    if (subs.empty())
+    {
+      subscriptions.erase(indexIt->second.second);
+    }
+  }
+  m_subscriptionIndex.erase(indexIt);
+  m_subscriptionCount--;
+  return true;
+}
+
+/**
+ * @brief return whether there are any subscriptions, allows to skip collecting changes
+ * 
+ * @return true / false
+ */
+bool spConfigNotifier::hasSubscribers()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return (m_subscriptionCount > 0);
+}
+
+/**
+ * @brief set whether callbacks are called inline or queued for dispatchQueued()
+ * 
+ * @param async  true for queuing
+ */
+void spConfigNotifier::setAsync(bool async)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_async = async;
+}
+
+/**
+ * @brief return whether callbacks are queued
+ * 
+ * @return true / false
+ */
+bool spConfigNotifier::getAsync()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_async;
+}
+
+/**
+ * @brief notify subscribers matching section and key about a change, either by calling them
+ *        inline or by queuing the change
+ * 
+ * @param section   name of section 
+ * @param key       name of key
+ * @param pOldValue  value before change or nullptr
+ * @param pNewValue  value after change or nullptr
+ * @return true / false  for change queued
+ */
+bool spConfigNotifier::notify(const char* section, const char* key, const spConfigValue* pOldValue, const spConfigValue* pNewValue)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_async)
+    {
+      m_queue.push_back({ section, key, 
+                          pOldValue ? *pOldValue : spConfigValue(), pNewValue ? *pNewValue : spConfigValue(),
+                          pOldValue != nullptr, pNewValue != nullptr });
+      return true;
+    }
+  }
+  dispatch(section, key, pOldValue, pNewValue);
+  return false;
+}
+
+/**
+ * @brief call subscribers for all queued changes
+ * 
+ * @return true / false  for any changes dispatched
+ */
+bool spConfigNotifier::dispatchQueued()
+{
+  std::deque<Change> queue;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    queue.swap(m_queue);
+  }
+  for (Change &change : queue)
+  {
+    dispatch(change.section.c_str(), change.key.c_str(), 
+             change.hasOldValue ? &change.oldValue : nullptr, change.hasNewValue ? &change.newValue : nullptr);
+  }
+  return !queue.empty();
+}
+
+
+
+/*    PRIVATE    PRIVATE    PRIVATE    PRIVATE
+
+      xxxxxxx   xxxxxxx      xx     xx    xx     xx     xxxxxxxx  xxxxxxxx
+      xx    xx  xx    xx     xx     xx    xx    xxxx       xx     xx      
+      xx    xx  xx    xx     xx     xx    xx   xx  xx      xx     xx      
+      xxxxxxx   xxxxxxx      xx      xx  xx   xx    xx     xx     xxxxxxx    
+      xx        xx    xx     xx      xx  xx   xxxxxxxx     xx     xx    
+      xx        xx    xx     xx       xxxx    xx    xx     xx     xx      
+      xx        xx    xx     xx        xx     xx    xx     xx     xxxxxxxx
+     
+
+      PRIVATE    PRIVATE    PRIVATE    PRIVATE    */
+
+
+/**
+ * @brief collect the callbacks of key or section subscriptions with the names given, 
+ *        found by hash without building strings, called with m_mutex locked
+ * 
+ * @param subscriptions  key or section subscriptions
+ * @param section 
+ * @param key  name of key or "" for section subscriptions
+ * @param callbacks  vector to add the callbacks to
+ */
+void spConfigNotifier::collectNamed(std::unordered_map<uint64_t, std::vector<NamedSubscription>> &subscriptions, const char* section, const char* key,
+                                    std::vector<spConfigChangeCallback> &callbacks)
+{
+  auto it = subscriptions.find(spConfigKey(section, key).hash());
+  if (it != subscriptions.end())
+  {
+    for (NamedSubscription &named : it->second)
+    {
+      if ((named.section == section) && (named.key == key))
+      {
+        callbacks.push_back(named.sub.callback);
+      }
+    }
+  }
+}
+
+/**
+ * @brief collect the callbacks of subscriptions matching section and key, 
+ *        visiting only the lists of the key, its section and the global ones
+ * 
+ * @param section 
+ * @param key 
+ * @param callbacks  vector to add the callbacks to
+ */
+void spConfigNotifier::collectCallbacks(const char* section, const char* key, std::vector<spConfigChangeCallback> &callbacks)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_subscriptionCount == 0)
+  {
+    return;
+  }
+  if (!m_keySubscriptions.empty())
+  {
+    collectNamed(m_keySubscriptions, section, key, callbacks);
+  }
+  if (!m_sectionSubscriptions.empty())
+  {
+    collectNamed(m_sectionSubscriptions, section, "", callbacks);
+  }
+  for (Subscription &sub : m_globalSubscriptions)
+  {
+    callbacks.push_back(sub.callback);
+  }
+}
+
+/**
+ * @brief call the matching subscribers, done outside of the lock to allow callbacks to 
+ *        change config values or subscriptions
+ * 
+ * @param section   name of section 
+ * @param key       name of key
+ * @param pOldValue  value before change or nullptr
+ * @param pNewValue  value after change or nullptr
+ */
+void spConfigNotifier::dispatch(const char* section, const char* key, const spConfigValue* pOldValue, const spConfigValue* pNewValue)
+{
+  std::vector<spConfigChangeCallback> callbacks;
+  collectCallbacks(section, key, callbacks);
+  for (spConfigChangeCallback &callback : callbacks)
+  {
+    callback(section, key, pOldValue, pNewValue);
+  }
+}
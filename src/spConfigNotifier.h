@@ -0,0 +1,88 @@
+/**
+ * @file spConfigNotifier.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to manage subscriptions to configuration changes
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version for change subscriptions
+ * 
+ */
+
+
+#ifndef SPCONFIGNOTIFIER_H
+#define SPCONFIGNOTIFIER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+
+#include <spLogHelper.h>
+#include <spConfigKey.h>
+#include <spConfigValue.h>
+
+
+// callback for changes, pOldValue / pNewValue are nullptr when the value did not exist before / does not exist anymore
+typedef std::function<void(const char* section, const char* key, const spConfigValue* pOldValue, const spConfigValue* pNewValue)> spConfigChangeCallback;
+
+
+class spConfigNotifier
+{
+  private:
+    struct Subscription
+    {
+      uint32_t id;
+      spConfigChangeCallback callback;
+    };
+    // key and section subscriptions are held by the hash of spConfigKey, with an empty key for sections,
+    // the names tell subscriptions apart, whose hashes collide
+    struct NamedSubscription
+    {
+      std::string section;
+      std::string key;
+      Subscription sub;
+    };
+    struct Change
+    {
+      std::string section;
+      std::string key;
+      spConfigValue oldValue;
+      spConfigValue newValue;
+      bool hasOldValue;
+      bool hasNewValue;
+    };
+    std::mutex m_mutex;
+    uint32_t m_lastId = 0;
+    size_t m_subscriptionCount = 0;
+    std::unordered_map<uint64_t, std::vector<NamedSubscription>> m_keySubscriptions;
+    std::unordered_map<uint64_t, std::vector<NamedSubscription>> m_sectionSubscriptions;
+    std::vector<Subscription> m_globalSubscriptions;
+    std::unordered_map<uint32_t, std::pair<int, uint64_t>> m_subscriptionIndex;
+    std::deque<Change> m_queue;
+    bool m_async = false;
+    //
+    void collectNamed(std::unordered_map<uint64_t, std::vector<NamedSubscription>> &subscriptions, const char* section, const char* key,
+                      std::vector<spConfigChangeCallback> &callbacks);
+    void collectCallbacks(const char* section, const char* key, std::vector<spConfigChangeCallback> &callbacks);
+    void dispatch(const char* section, const char* key, const spConfigValue* pOldValue, const spConfigValue* pNewValue);
+
+  public:
+    uint32_t subscribe(const char* section, const char* key, spConfigChangeCallback callback);
+    bool unsubscribe(uint32_t subscriptionId);
+    bool hasSubscribers();
+    void setAsync(bool async);
+    bool getAsync();
+    bool notify(const char* section, const char* key, const spConfigValue* pOldValue, const spConfigValue* pNewValue);
+    bool dispatchQueued();
+
+};
+
+#endif // SPCONFIGNOTIFIER_H
+
+
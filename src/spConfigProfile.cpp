@@ -0,0 +1,176 @@
+/**
+ * @file spConfigProfile.cpp
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to count reads of config values by key
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <spConfigProfile.h>
+
+
+/*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
+
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx      xxxxxx 
+      xx    xx  xx    xx  xx    xx  xx           xx     xx    xx
+      xx    xx  xx    xx  xx    xx  xx           xx     xx      
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx    xx
+      xx         xxxxxx   xxxxxxx   xxxxxxxx     xx      xxxxxx 
+     
+
+      PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
+
+
+
+
+/**
+ * @brief allocate the counters, if not yet done, to be called before the first count()
+ * 
+ */
+void spConfigProfile::allocate()
+{
+  if (!m_pSlots)
+  {
+    m_pSlots.reset(new Slot[SPCONFIG_PROFILE_SLOTS]);
+    m_pTable.store(m_pSlots.get(), std::memory_order_release);
+  }
+}
+
+/**
+ * @brief count only every n-th read of each thread, adding n to the counter of the key read, so the
+ *        counts become estimates with less contention on the counters of hot keys
+ * 
+ * @param sampleRate  n, 1 to count every read
+ */
+void spConfigProfile::setSampleRate(uint32_t sampleRate)
+{
+  m_sampleRate.store((sampleRate > 0) ? sampleRate : 1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief return the sample rate
+ * 
+ * @return uint32_t 
+ */
+uint32_t spConfigProfile::getSampleRate() const
+{
+  return m_sampleRate.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief count a read of a key
+ * 
+ * @param hash  hash of section and key, see spConfigKey::hash()
+ */
+void spConfigProfile::count(uint64_t hash)
+{
+  Slot* pTable = m_pTable.load(std::memory_order_acquire);
+  if (!pTable)
+  {
+    return;
+  }
+  uint32_t sampleRate = m_sampleRate.load(std::memory_order_relaxed);
+  if (sampleRate > 1)
+  {
+    thread_local uint32_t t_skipped = 0;
+    if (++t_skipped < sampleRate)
+    {
+      return;
+    }
+    t_skipped = 0;
+  }
+
+  // 0 marks free slots
+  if (hash == 0)
+  {
+    hash = 1;
+  }
+  size_t idx = hash & (SPCONFIG_PROFILE_SLOTS - 1);
+  for (size_t i = 0; i < SPCONFIG_PROFILE_PROBES; i++)
+  {
+    Slot &slot = pTable[idx];
+    uint64_t slotHash = slot.hash.load(std::memory_order_relaxed);
+    if (slotHash == 0)
+    {
+      // claim free slot, unless another thread was faster
+      slot.hash.compare_exchange_strong(slotHash, hash, std::memory_order_relaxed);
+      if (slotHash == 0)
+      {
+        slotHash = hash;
+      }
+    }
+    if (slotHash == hash)
+    {
+      slot.count.fetch_add(sampleRate, std::memory_order_relaxed);
+      return;
+    }
+    idx = (idx + 1) & (SPCONFIG_PROFILE_SLOTS - 1);
+  }
+  m_overflow.fetch_add(sampleRate, std::memory_order_relaxed);
+}
+
+/**
+ * @brief return the reads counted for a key
+ * 
+ * @param hash  hash of section and key, see spConfigKey::hash()
+ * @return uint64_t  number of reads or 0
+ */
+uint64_t spConfigProfile::reads(uint64_t hash) const
+{
+  Slot* pTable = m_pTable.load(std::memory_order_acquire);
+  if (!pTable)
+  {
+    return 0;
+  }
+  if (hash == 0)
+  {
+    hash = 1;
+  }
+  size_t idx = hash & (SPCONFIG_PROFILE_SLOTS - 1);
+  for (size_t i = 0; i < SPCONFIG_PROFILE_PROBES; i++)
+  {
+    uint64_t slotHash = pTable[idx].hash.load(std::memory_order_relaxed);
+    if (slotHash == hash)
+    {
+      return pTable[idx].count.load(std::memory_order_relaxed);
+    }
+    if (slotHash == 0)
+    {
+      break;
+    }
+    idx = (idx + 1) & (SPCONFIG_PROFILE_SLOTS - 1);
+  }
+  return 0;
+}
+
+/**
+ * @brief return the reads of keys not counted, as all slots tried for them were taken
+ * 
+ * @return uint64_t 
+ */
+uint64_t spConfigProfile::overflow() const
+{
+  return m_overflow.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief set all counters to 0 and free their slots, reads counted at the same time may get lost
+ * 
+ */
+void spConfigProfile::clear()
+{
+  Slot* pTable = m_pTable.load(std::memory_order_acquire);
+  if (pTable)
+  {
+    for (size_t i = 0; i < SPCONFIG_PROFILE_SLOTS; i++)
+    {
+      pTable[i].hash.store(0, std::memory_order_relaxed);
+      pTable[i].count.store(0, std::memory_order_relaxed);
+    }
+  }
+  m_overflow.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file spConfigProfile.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to count reads of config values by key
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version
+ * 
+ */
+
+
+#ifndef SPCONFIGPROFILE_H
+#define SPCONFIGPROFILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <memory>
+#include <atomic>
+
+
+// number of keys counted, a power of 2, reads of further keys are only counted as overflow
+#ifndef SPCONFIG_PROFILE_SLOTS
+  #define SPCONFIG_PROFILE_SLOTS  4096
+#endif
+
+// slots tried for a key before its reads are counted as overflow
+#define SPCONFIG_PROFILE_PROBES  32
+
+
+// reads of a value by section and key
+struct spConfigKeyReads
+{
+  std::string section;
+  std::string key;
+  uint64_t reads = 0;
+};
+
+
+class spConfigProfile
+{
+  private:
+    // counter of a key identified by its hash, 0 for a free slot
+    struct Slot
+    {
+      std::atomic<uint64_t> hash{0};
+      std::atomic<uint64_t> count{0};
+    };
+    static_assert((SPCONFIG_PROFILE_SLOTS & (SPCONFIG_PROFILE_SLOTS - 1)) == 0, "SPCONFIG_PROFILE_SLOTS must be a power of 2");
+    // allocated once and kept until destruction, as reads may still count while profiling is stopped
+    std::unique_ptr<Slot[]> m_pSlots;
+    std::atomic<Slot*> m_pTable{nullptr};
+    std::atomic<uint32_t> m_sampleRate{1};
+    std::atomic<uint64_t> m_overflow{0};
+
+  public:
+    void allocate();
+    void setSampleRate(uint32_t sampleRate);
+    uint32_t getSampleRate() const;
+    void count(uint64_t hash);
+    uint64_t reads(uint64_t hash) const;
+    uint64_t overflow() const;
+    void clear();
+
+};
+
+#endif // SPCONFIGPROFILE_H
@@ -0,0 +1,570 @@
+/**
+ * @file spConfigStorage.cpp
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief classes to access configuration files through open handles
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <spConfigStorage.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <thread>
+#include <chrono>
+
+#ifdef SPCONFIG_POSIX_STORAGE
+  #include <unistd.h>
+  #include <fcntl.h>
+  #include <sys/stat.h>
+#endif
+#ifdef SPCONFIG_MMAP_STORAGE
+  #include <sys/mman.h>
+#endif
+
+
+/*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
+
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx      xxxxxx 
+      xx    xx  xx    xx  xx    xx  xx           xx     xx    xx
+      xx    xx  xx    xx  xx    xx  xx           xx     xx      
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx    xx
+      xx         xxxxxx   xxxxxxx   xxxxxxxx     xx      xxxxxx 
+     
+
+      PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
+
+
+
+/**
+ * @brief return the whole content of a file opened for reading without copying it, the content
+ *        remains valid until the file is closed, the base function has no view of the content
+ * 
+ * @param file  file opened with openRead()
+ * @param content  data and size of content
+ * @return true / false  for content available, otherwise the file must be read with read()
+ */
+bool spConfigStorage::view(spConfigFile & /*file*/, spConfigSpan & /*content*/)
+{
+  return false;
+}
+
+
+/**
+ * @brief open a file of the memory storage for reading
+ * 
+ * @param filename  name of file
+ * @param file  handle of opened file
+ * @return true / false  for file existing
+ */
+bool spConfigMemoryStorage::openRead(const char* filename, spConfigFile &file)
+{
+  if (m_faults & SPCONFIG_FAULT_OPENREAD)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_files.find(filename);
+  if (it == m_files.end())
+  {
+    return false;
+  }
+  file.pData = &it->second;
+  file.size = it->second.size();
+  return true;
+}
+
+/**
+ * @brief return the content of a file of the memory storage
+ * 
+ * @param file  file opened with openRead()
+ * @param content  data and size of content
+ * @return true
+ */
+bool spConfigMemoryStorage::view(spConfigFile &file, spConfigSpan &content)
+{
+  delay(m_readLatencyUS);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::string* pContent = static_cast<std::string*>(file.pData);
+  content.data = pContent->data();
+  content.size = pContent->size();
+  return true;
+}
+
+/**
+ * @brief copy content of a file of the memory storage
+ * 
+ * @param file  file opened with openRead()
+ * @param pos  position in file to start reading
+ * @param buf  buffer to hold content
+ * @param len  max number of bytes to read
+ * @return size_t  actual number of bytes read
+ */
+size_t spConfigMemoryStorage::read(spConfigFile &file, size_t pos, char* buf, size_t len)
+{
+  delay(m_readLatencyUS);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::string* pContent = static_cast<std::string*>(file.pData);
+  if (pos >= pContent->size())
+  {
+    return 0;
+  }
+  return pContent->copy(buf, len, pos);
+}
+
+/**
+ * @brief create or truncate a file of the memory storage for writing
+ * 
+ * @param filename  name of file
+ * @param file  handle of opened file
+ * @return true
+ */
+bool spConfigMemoryStorage::openWrite(const char* filename, spConfigFile &file)
+{
+  if (m_faults & SPCONFIG_FAULT_OPENWRITE)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::string &content = m_files[filename];
+  content.clear();
+  file.pData = &content;
+  file.size = 0;
+  return true;
+}
+
+/**
+ * @brief append data to a file of the memory storage, only as much as the write limit allows
+ * 
+ * @param file  file opened with openWrite()
+ * @param data  data to write
+ * @return true / false  for all data written
+ */
+bool spConfigMemoryStorage::write(spConfigFile &file, spConfigSpan data)
+{
+  delay(m_writeLatencyUS);
+  if (m_faults & SPCONFIG_FAULT_WRITE)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::string* pContent = static_cast<std::string*>(file.pData);
+  size_t accepted = (data.size < m_writeLimit) ? data.size : m_writeLimit;
+  if (m_writeLimit != SIZE_MAX)
+  {
+    m_writeLimit -= accepted;
+  }
+  pContent->append(data.data, accepted);
+  file.size = pContent->size();
+  return accepted == data.size;
+}
+
+/**
+ * @brief nothing to sync for the memory storage, but the write latency
+ * 
+ * @param file  file opened with openWrite()
+ * @return true / false  for success
+ */
+bool spConfigMemoryStorage::sync(spConfigFile & /*file*/)
+{
+  delay(m_writeLatencyUS);
+  return (m_faults & SPCONFIG_FAULT_SYNC) == 0;
+}
+
+/**
+ * @brief close a file of the memory storage
+ * 
+ * @param file  opened file
+ * @return true
+ */
+bool spConfigMemoryStorage::close(spConfigFile &file)
+{
+  file.pData = nullptr;
+  file.size = 0;
+  return true;
+}
+
+/**
+ * @brief rename a file of the memory storage, replacing an existing file with the new name
+ * 
+ * @param from  name of file
+ * @param to  new name of file
+ * @return true / false  for file existing
+ */
+bool spConfigMemoryStorage::rename(const char* from, const char* to)
+{
+  if (m_faults & SPCONFIG_FAULT_RENAME)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_files.find(from);
+  if (it == m_files.end())
+  {
+    return false;
+  }
+  if (strcmp(from, to) != 0)
+  {
+    m_files[to].swap(it->second);
+    m_files.erase(it);
+  }
+  return true;
+}
+
+/**
+ * @brief remove a file of the memory storage
+ * 
+ * @param filename  name of file
+ * @return true / false  for file existing
+ */
+bool spConfigMemoryStorage::remove(const char* filename)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_files.erase(filename) > 0;
+}
+
+/**
+ * @brief create or replace a file of the memory storage, e.g. to provide a configuration file
+ * 
+ * @param filename  name of file
+ * @param content  content of file
+ * @param len  length of content
+ */
+void spConfigMemoryStorage::setFile(const char* filename, const char* content, size_t len)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_files[filename].assign(content, len);
+}
+
+/**
+ * @brief copy the content of a file of the memory storage, e.g. to check a saved configuration file
+ * 
+ * @param filename  name of file
+ * @param content  content of file
+ * @return true / false  for file existing
+ */
+bool spConfigMemoryStorage::getFile(const char* filename, std::string &content)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_files.find(filename);
+  if (it == m_files.end())
+  {
+    return false;
+  }
+  content = it->second;
+  return true;
+}
+
+/**
+ * @brief let operations of the memory storage fail, e.g. to test the handling of errors
+ * 
+ * @param faults  combination of SPCONFIG_FAULT_... flags or 0 for none
+ */
+void spConfigMemoryStorage::setFaults(uint32_t faults)
+{
+  m_faults = faults;
+}
+
+/**
+ * @brief accept only the number of bytes given by all writes thereafter, further data is cut off 
+ *        as by a full device or a power loss, the write exceeding the limit fails
+ * 
+ * @param bytes  number of bytes or SIZE_MAX for no limit
+ */
+void spConfigMemoryStorage::setWriteLimit(size_t bytes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_writeLimit = bytes;
+}
+
+/**
+ * @brief delay reads and writes or syncs of the memory storage, e.g. to simulate a slow device
+ * 
+ * @param readUS  delay of each read in microseconds
+ * @param writeUS  delay of each write and sync in microseconds
+ */
+void spConfigMemoryStorage::setLatency(uint32_t readUS, uint32_t writeUS)
+{
+  m_readLatencyUS = readUS;
+  m_writeLatencyUS = writeUS;
+}
+
+
+/**
+ * @brief sleep for the latency given
+ * 
+ * @param latencyUS  latency in microseconds, 0 for none
+ */
+void spConfigMemoryStorage::delay(uint32_t latencyUS)
+{
+  if (latencyUS > 0)
+  {
+    std::this_thread::sleep_for(std::chrono::microseconds(latencyUS));
+  }
+}
+
+
+#ifdef SPCONFIG_POSIX_STORAGE
+
+/**
+ * @brief open a file for reading
+ * 
+ * @param filename  name of file
+ * @param file  handle of opened file with its size
+ * @return true / false  for success
+ */
+bool spConfigPosixStorage::openRead(const char* filename, spConfigFile &file)
+{
+  int fd = ::open(filename, O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    ::close(fd);
+    return false;
+  }
+  file.handle = fd;
+  file.pData = nullptr;
+  file.size = st.st_size;
+  return true;
+}
+
+/**
+ * @brief read from a file at the position given without moving a file position
+ * 
+ * @param file  file opened with openRead()
+ * @param pos  position in file to start reading
+ * @param buf  buffer to hold content
+ * @param len  max number of bytes to read
+ * @return size_t  actual number of bytes read
+ */
+size_t spConfigPosixStorage::read(spConfigFile &file, size_t pos, char* buf, size_t len)
+{
+  size_t received = 0;
+  while (received < len)
+  {
+    ssize_t n = pread((int)file.handle, buf + received, len - received, pos + received);
+    if (n < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (n <= 0)
+    {
+      break;
+    }
+    received += n;
+  }
+  return received;
+}
+
+/**
+ * @brief create or truncate a file for writing
+ * 
+ * @param filename  name of file
+ * @param file  handle of opened file
+ * @return true / false  for success
+ */
+bool spConfigPosixStorage::openWrite(const char* filename, spConfigFile &file)
+{
+  int fd = ::open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    spLOGF_E("spConfigPosixStorage::openWrite() failed to open %s", filename);
+    return false;
+  }
+  file.handle = fd;
+  file.pData = nullptr;
+  file.size = 0;
+  return true;
+}
+
+/**
+ * @brief append data to a file
+ * 
+ * @param file  file opened with openWrite()
+ * @param data  data to write
+ * @return true / false  for all data written
+ */
+bool spConfigPosixStorage::write(spConfigFile &file, spConfigSpan data)
+{
+  size_t written = 0;
+  while (written < data.size)
+  {
+    ssize_t n = ::write((int)file.handle, data.data + written, data.size - written);
+    if (n < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (n <= 0)
+    {
+      return false;
+    }
+    written += n;
+  }
+  file.size += written;
+  return true;
+}
+
+/**
+ * @brief flush a file to the device
+ * 
+ * @param file  file opened with openWrite()
+ * @return true / false  for success
+ */
+bool spConfigPosixStorage::sync(spConfigFile &file)
+{
+  return fsync((int)file.handle) == 0;
+}
+
+/**
+ * @brief close a file
+ * 
+ * @param file  opened file
+ * @return true / false  for success
+ */
+bool spConfigPosixStorage::close(spConfigFile &file)
+{
+  int ret = ::close((int)file.handle);
+  file.handle = -1;
+  file.size = 0;
+  return ret == 0;
+}
+
+/**
+ * @brief rename a file, replacing an existing file with the new name in one step, and flush the
+ *        directory, so the new name survives a power loss
+ * 
+ * @param from  name of file
+ * @param to  new name of file
+ * @return true / false  for success
+ */
+bool spConfigPosixStorage::rename(const char* from, const char* to)
+{
+  if (::rename(from, to) != 0)
+  {
+    spLOGF_E("spConfigPosixStorage::rename() failed to rename %s to %s", from, to);
+    return false;
+  }
+  const char* sep = strrchr(to, '/');
+  std::string dir = (sep == nullptr) ? std::string(".") : std::string(to, (sep == to) ? 1 : sep - to);
+  int fd = ::open(dir.c_str(), O_RDONLY);
+  if (fd >= 0)
+  {
+    fsync(fd);
+    ::close(fd);
+  }
+  return true;
+}
+
+/**
+ * @brief remove a file
+ * 
+ * @param filename  name of file
+ * @return true / false  for success
+ */
+bool spConfigPosixStorage::remove(const char* filename)
+{
+  return unlink(filename) == 0;
+}
+
+#endif // SPCONFIG_POSIX_STORAGE
+
+
+#ifdef SPCONFIG_MMAP_STORAGE
+
+/**
+ * @brief open a file for reading and map its content into memory
+ * 
+ * @param filename  name of file
+ * @param file  handle of opened file with mapped content and its size
+ * @return true / false  for success
+ */
+bool spConfigMmapStorage::openRead(const char* filename, spConfigFile &file)
+{
+  if (!spConfigPosixStorage::openRead(filename, file))
+  {
+    return false;
+  }
+  if (file.size > 0)
+  {
+    void* pData = mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE, (int)file.handle, 0);
+    if (pData == MAP_FAILED)
+    {
+      // still readable with read()
+      spLOGF_D("spConfigMmapStorage::openRead() could not map %s", filename);
+      pData = nullptr;
+    }
+    file.pData = pData;
+  }
+  return true;
+}
+
+/**
+ * @brief return the mapped content of a file
+ * 
+ * @param file  file opened with openRead()
+ * @param content  data and size of content
+ * @return true / false  for content mapped
+ */
+bool spConfigMmapStorage::view(spConfigFile &file, spConfigSpan &content)
+{
+  if (file.pData == nullptr)
+  {
+    return false;
+  }
+  content.data = static_cast<const char*>(file.pData);
+  content.size = file.size;
+  return true;
+}
+
+/**
+ * @brief copy mapped content of a file or read it, if not mapped
+ * 
+ * @param file  file opened with openRead()
+ * @param pos  position in file to start reading
+ * @param buf  buffer to hold content
+ * @param len  max number of bytes to read
+ * @return size_t  actual number of bytes read
+ */
+size_t spConfigMmapStorage::read(spConfigFile &file, size_t pos, char* buf, size_t len)
+{
+  if (file.pData == nullptr)
+  {
+    return spConfigPosixStorage::read(file, pos, buf, len);
+  }
+  if (pos >= file.size)
+  {
+    return 0;
+  }
+  if (len > file.size - pos)
+  {
+    len = file.size - pos;
+  }
+  memcpy(buf, static_cast<const char*>(file.pData) + pos, len);
+  return len;
+}
+
+/**
+ * @brief unmap the content and close a file
+ * 
+ * @param file  opened file
+ * @return true / false  for success
+ */
+bool spConfigMmapStorage::close(spConfigFile &file)
+{
+  if (file.pData != nullptr)
+  {
+    munmap(file.pData, file.size);
+    file.pData = nullptr;
+  }
+  return spConfigPosixStorage::close(file);
+}
+
+#endif // SPCONFIG_MMAP_STORAGE
@@ -0,0 +1,146 @@
+/**
+ * @file spConfigStorage.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief classes to access configuration files through open handles
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version with POSIX, in-memory and memory mapped storage
+ *          faults and latency injected into the in-memory storage
+ * 
+ */
+
+
+#ifndef SPCONFIGSTORAGE_H
+#define SPCONFIGSTORAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <map>
+#include <mutex>
+#include <atomic>
+
+#include <spLogHelper.h>
+
+
+// POSIX storage with platforms providing file descriptors, memory mapped storage only with mmap()
+#if defined(__has_include)
+  #if __has_include(<unistd.h>) && __has_include(<fcntl.h>) && __has_include(<sys/stat.h>)
+    #define SPCONFIG_POSIX_STORAGE 1
+  #endif
+  #if defined(SPCONFIG_POSIX_STORAGE) && __has_include(<sys/mman.h>)
+    #define SPCONFIG_MMAP_STORAGE 1
+  #endif
+#endif
+
+
+// operations of spConfigMemoryStorage failing after setFaults()
+#define SPCONFIG_FAULT_OPENREAD   0x01
+#define SPCONFIG_FAULT_OPENWRITE  0x02
+#define SPCONFIG_FAULT_WRITE      0x04
+#define SPCONFIG_FAULT_SYNC       0x08
+#define SPCONFIG_FAULT_RENAME     0x10
+
+
+// view of file content or of data to write, not owning the data
+struct spConfigSpan
+{
+  const char* data = nullptr;
+  size_t size = 0;
+};
+
+// file opened by a storage, the meaning of the members is up to the storage class
+struct spConfigFile
+{
+  intptr_t handle = -1;
+  void* pData = nullptr;
+  size_t size = 0;
+};
+
+
+class spConfigStorage
+{
+  public:
+    virtual ~spConfigStorage() {}
+    virtual bool openRead(const char* filename, spConfigFile &file) = 0;
+    virtual bool view(spConfigFile &file, spConfigSpan &content);
+    virtual size_t read(spConfigFile &file, size_t pos, char* buf, size_t len) = 0;
+    virtual bool openWrite(const char* filename, spConfigFile &file) = 0;
+    virtual bool write(spConfigFile &file, spConfigSpan data) = 0;
+    virtual bool sync(spConfigFile &file) = 0;
+    virtual bool close(spConfigFile &file) = 0;
+    virtual bool rename(const char* from, const char* to) = 0;
+    virtual bool remove(const char* filename) = 0;
+
+};
+
+
+class spConfigMemoryStorage final : public spConfigStorage
+{
+  private:
+    std::mutex m_mutex; // guards files, content viewed must not be replaced while read
+    // content by filename, nodes of map keep their address
+    std::map<std::string, std::string> m_files;
+    std::atomic<uint32_t> m_faults{0};
+    size_t m_writeLimit = SIZE_MAX; // bytes accepted by writes before they are cut short
+    std::atomic<uint32_t> m_readLatencyUS{0};
+    std::atomic<uint32_t> m_writeLatencyUS{0};
+    //
+    static void delay(uint32_t latencyUS);
+
+  public:
+    bool openRead(const char* filename, spConfigFile &file) override;
+    bool view(spConfigFile &file, spConfigSpan &content) override;
+    size_t read(spConfigFile &file, size_t pos, char* buf, size_t len) override;
+    bool openWrite(const char* filename, spConfigFile &file) override;
+    bool write(spConfigFile &file, spConfigSpan data) override;
+    bool sync(spConfigFile &file) override;
+    bool close(spConfigFile &file) override;
+    bool rename(const char* from, const char* to) override;
+    bool remove(const char* filename) override;
+    void setFile(const char* filename, const char* content, size_t len);
+    bool getFile(const char* filename, std::string &content);
+    void setFaults(uint32_t faults);
+    void setWriteLimit(size_t bytes);
+    void setLatency(uint32_t readUS, uint32_t writeUS);
+
+};
+
+
+#ifdef SPCONFIG_POSIX_STORAGE
+
+class spConfigPosixStorage : public spConfigStorage
+{
+  public:
+    bool openRead(const char* filename, spConfigFile &file) override;
+    size_t read(spConfigFile &file, size_t pos, char* buf, size_t len) override;
+    bool openWrite(const char* filename, spConfigFile &file) override;
+    bool write(spConfigFile &file, spConfigSpan data) override;
+    bool sync(spConfigFile &file) override;
+    bool close(spConfigFile &file) override;
+    bool rename(const char* from, const char* to) override;
+    bool remove(const char* filename) override;
+
+};
+
+#endif // SPCONFIG_POSIX_STORAGE
+
+
+#ifdef SPCONFIG_MMAP_STORAGE
+
+class spConfigMmapStorage final : public spConfigPosixStorage
+{
+  public:
+    bool openRead(const char* filename, spConfigFile &file) override;
+    bool view(spConfigFile &file, spConfigSpan &content) override;
+    size_t read(spConfigFile &file, size_t pos, char* buf, size_t len) override;
+    bool close(spConfigFile &file) override;
+
+};
+
+#endif // SPCONFIG_MMAP_STORAGE
+
+#endif // SPCONFIGSTORAGE_H
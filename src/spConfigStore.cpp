@@ -0,0 +1,857 @@
+/**
+ * @file spConfigStore.cpp
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to store config values by section and key
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <spConfigStore.h>
+#include <algorithm>
+
+
+// initial number of hash slots, must be a power of 2
+#define SPCONFIG_STORE_MINSLOTS  16
+
+
+/*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
+
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx      xxxxxx 
+      xx    xx  xx    xx  xx    xx  xx           xx     xx    xx
+      xx    xx  xx    xx  xx    xx  xx           xx     xx      
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx    xx
+      xx         xxxxxx   xxxxxxx   xxxxxxxx     xx      xxxxxx 
+     
+
+      PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
+
+
+/**
+ * @brief Construct a new store, which allocates entries and values individually or, with an upstream 
+ *        memory resource, from an arena taking memory in blocks from upstream and releasing them 
+ *        all at once, when the store is destroyed or reset
+ * 
+ * @param pNames  name pool for section and key names or nullptr for a new pool
+ * @param pUpstream  memory resource for the arena or nullptr for individual allocations
+ */
+spConfigStore::spConfigStore(spConfigNamePoolPtr pNames, std::pmr::memory_resource* pUpstream) : m_pNames(pNames), 
+    m_pArena(pUpstream ? new std::pmr::monotonic_buffer_resource(pUpstream) : nullptr),
+    m_pResource(m_pArena ? m_pArena.get() : std::pmr::new_delete_resource()),
+    m_ownsText(false),
+    m_sections(m_pResource),
+    m_capacity(0),
+    m_minSlots(slotsFor(0)),
+    m_slots(m_minSlots, Slot{ nullptr, nullptr }, m_pResource)
+{
+  if (!m_pNames)
+  {
+    m_pNames = std::make_shared<spConfigNamePool>();
+  }
+  m_memoryUsed = m_slots.size() * sizeof(Slot);
+}
+
+/**
+ * @brief Construct a new store holding at most capacity values in an index sized once, which takes 
+ *        all memory from the fixed memory given, checking beforehand that it fits, so set() fails 
+ *        instead of running out of memory
+ *        the caller checks that indexBytes() fit, see spConfigFixedMemory::fits()
+ * 
+ * @param pNames  name pool for section and key names, which should take its memory from pFixed as well
+ * @param pFixed  fixed memory or nullptr for individual allocations
+ * @param capacity  maximum number of values, at least 1
+ */
+spConfigStore::spConfigStore(spConfigNamePoolPtr pNames, spConfigFixedMemory* pFixed, size_t capacity) : m_pNames(pNames), 
+    m_pFixed(pFixed),
+    m_pResource(pFixed ? static_cast<std::pmr::memory_resource*>(pFixed) : std::pmr::new_delete_resource()),
+    m_ownsText(pFixed != nullptr),
+    m_sections(m_pResource),
+    m_capacity(capacity),
+    m_minSlots(slotsFor(capacity)),
+    m_slots(m_minSlots, Slot{ nullptr, nullptr }, m_pResource)
+{
+  if (!m_pNames)
+  {
+    m_pNames = std::make_shared<spConfigNamePool>();
+  }
+  m_memoryUsed = m_slots.size() * sizeof(Slot);
+}
+
+spConfigStore::~spConfigStore()
+{
+  for (Sections::value_type &section : m_sections)
+  {
+    releaseTexts(section.second);
+  }
+}
+
+/**
+ * @brief return the value stored for section and key
+ * 
+ * @param key  section and key with hash
+ * @return spConfigValue*  pointer to value or nullptr if not found
+ */
+spConfigValue* spConfigStore::find(const spConfigKey &key) const
+{
+  size_t idx = findSlot(key);
+  if (m_slots[idx].pNode)
+  {
+    return &m_slots[idx].pNode->second.value;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief add value for section and key or replace the value already stored
+ * 
+ * @param key  section and key with hash
+ * @param value 
+ * @return spConfigValue*  pointer to value stored
+ */
+spConfigValue* spConfigStore::set(const spConfigKey &key, const spConfigValue &value)
+{
+  // other stores in the same fixed memory must not take the memory checked before it is used
+  std::unique_lock<spConfigFixedMemory> memoryLock;
+  if (m_pFixed)
+  {
+    memoryLock = std::unique_lock<spConfigFixedMemory>(*m_pFixed);
+  }
+  size_t idx = findSlot(key);
+  if (m_slots[idx].pNode)
+  {
+    spConfigValue &current = m_slots[idx].pNode->second.value;
+    size_t oldBytes = textBytes(current);
+    if ((m_memoryLimit > 0) && !checkMemory(key, oldBytes, textBytesFor(&current, value.c_str()), false))
+    {
+      return nullptr;
+    }
+    if (m_pFixed && !checkFixedMemory(key, &current, value.c_str()))
+    {
+      return nullptr;
+    }
+    if (m_ownsText)
+    {
+      setText(current, value);
+    }
+    else
+    {
+      // a value outgrowing its text in the arena continues in a buffer of its own
+      bool borrowed = current.m_borrowed;
+      current = value;
+      if (borrowed && !current.m_borrowed)
+      {
+        m_arenaWaste += oldBytes;
+      }
+    }
+    m_memoryUsed = m_memoryUsed - oldBytes + textBytes(current);
+    return &current;
+  }
+  if ((m_capacity > 0) && (m_count >= m_capacity))
+  {
+    spLOGF_E("spConfigStore::set() failed for %.*s / %.*s, as all %u values are used", (int)key.sectionLength(), key.section(), 
+             (int)key.keyLength(), key.key(), (unsigned int)m_capacity);
+    return nullptr;
+  }
+  if ((m_memoryLimit > 0) && !checkMemory(key, 0, textBytesFor(nullptr, value.c_str()), true))
+  {
+    return nullptr;
+  }
+  if (m_pFixed && !checkFixedMemory(key, nullptr, value.c_str()))
+  {
+    return nullptr;
+  }
+  return insert(key, value);
+}
+
+/**
+ * @brief remove the value stored for section and key and the section, when it was the last key
+ * 
+ * @param key  section and key with hash
+ * @return true / false  for value found and removed
+ */
+bool spConfigStore::remove(const spConfigKey &key)
+{
+  size_t idx = findSlot(key);
+  Slot slot = m_slots[idx];
+  if (!slot.pNode)
+  {
+    return false;
+  }
+  eraseSlot(idx);
+  m_memoryUsed -= entryBytes(*slot.pNode);
+  if (m_pArena)
+  {
+    m_arenaWaste += entryBytes(*slot.pNode);
+  }
+  releaseText(slot.pNode->second.value);
+  Keys &keys = slot.pSection->second;
+  keys.erase(keys.find(slot.pNode->first));
+  if (keys.empty())
+  {
+    m_memoryUsed -= sectionBytes(*slot.pSection);
+    if (m_pArena)
+    {
+      m_arenaWaste += sectionBytes(*slot.pSection);
+    }
+    m_sections.erase(m_sections.find(slot.pSection->first));
+  }
+  m_count--;
+  return true;
+}
+
+/**
+ * @brief remove all values of a section, taking time proportional to the section's size only
+ * 
+ * @param section   name of section
+ * @return size_t  number of values removed
+ */
+size_t spConfigStore::removeSection(const char* section)
+{
+  auto sectionIt = m_sections.find(section ? section : "");
+  if (sectionIt == m_sections.end())
+  {
+    return 0;
+  }
+  size_t removed = sectionIt->second.size();
+  for (Keys::value_type &node : sectionIt->second)
+  {
+    eraseSlot(findSlot(&node));
+    m_memoryUsed -= entryBytes(node);
+  }
+  m_memoryUsed -= sectionBytes(*sectionIt);
+  if (m_pArena)
+  {
+    for (Keys::value_type &node : sectionIt->second)
+    {
+      m_arenaWaste += entryBytes(node);
+    }
+    m_arenaWaste += sectionBytes(*sectionIt);
+  }
+  releaseTexts(sectionIt->second);
+  m_sections.erase(sectionIt);
+  m_count -= removed;
+  return removed;
+}
+
+/**
+ * @brief remove all values and release the memory of the arena, while the index in fixed memory is kept
+ * 
+ */
+void spConfigStore::reset()
+{
+  for (Sections::value_type &section : m_sections)
+  {
+    releaseTexts(section.second);
+  }
+  m_sections.clear();
+  if (m_pFixed)
+  {
+    std::fill(m_slots.begin(), m_slots.end(), Slot{ nullptr, nullptr });
+  }
+  else
+  {
+    // containers give up their memory before the arena releases it and are then rebuilt
+    std::pmr::vector<Slot>(m_pResource).swap(m_slots);
+    if (m_pArena)
+    {
+      m_pArena->release();
+    }
+    m_slots.assign(m_minSlots, Slot{ nullptr, nullptr });
+  }
+  m_count = 0;
+  m_arenaWaste = 0;
+  m_memoryUsed = m_slots.size() * sizeof(Slot);
+}
+
+/**
+ * @brief return number of values stored
+ * 
+ * @return size_t 
+ */
+size_t spConfigStore::count() const
+{
+  return m_count;
+}
+
+/**
+ * @brief return maximum number of values or 0 for no limit
+ * 
+ * @return size_t 
+ */
+size_t spConfigStore::capacity() const
+{
+  return m_capacity;
+}
+
+/**
+ * @brief return the bytes of the index a store of fixed capacity takes, when constructed
+ * 
+ * @param capacity  maximum number of values
+ * @return size_t 
+ */
+size_t spConfigStore::indexBytes(size_t capacity)
+{
+  return slotsFor(capacity) * sizeof(Slot);
+}
+
+/**
+ * @brief return the pool holding the names of sections and keys, e.g. to share it with other stores
+ * 
+ * @return spConfigNamePoolPtr 
+ */
+spConfigNamePoolPtr spConfigStore::getNamePool() const
+{
+  return m_pNames;
+}
+
+/**
+ * @brief returns whether entries and values are allocated from an arena
+ * 
+ * @return true / false 
+ */
+bool spConfigStore::usesArena() const
+{
+  return (m_pArena != nullptr);
+}
+
+/**
+ * @brief return the estimated bytes of the arena no longer used by values, e.g. of removed entries, 
+ *        which are only released with the arena, see spConfigBase::compactStore()
+ * 
+ * @return size_t 
+ */
+size_t spConfigStore::arenaWaste() const
+{
+  return m_arenaWaste;
+}
+
+/**
+ * @brief return the estimated bytes of entries, text and hash table, names are counted for each use
+ * 
+ * @return size_t 
+ */
+size_t spConfigStore::memoryUsed() const
+{
+  return m_memoryUsed;
+}
+
+/**
+ * @brief return the memory limit or 0 for no limit
+ * 
+ * @return size_t 
+ */
+size_t spConfigStore::getMemoryLimit() const
+{
+  return m_memoryLimit;
+}
+
+/**
+ * @brief set a limit for memoryUsed(), which makes set() fail, when adding or replacing a value would 
+ *        exceed it, while values already stored are kept
+ * 
+ * @param bytes  maximum of estimated bytes or 0 for no limit
+ */
+void spConfigStore::setMemoryLimit(size_t bytes)
+{
+  m_memoryLimit = bytes;
+}
+
+/**
+ * @brief add the estimated memory of each section and of the hash table to a report, combining 
+ *        sections with those of other stores already in the report
+ * 
+ * @param usage  report to add to
+ */
+void spConfigStore::memoryUsage(spConfigMemoryUsage &usage) const
+{
+  for (const Sections::value_type &section : m_sections)
+  {
+    auto it = std::lower_bound(usage.sections.begin(), usage.sections.end(), section.first, 
+                               [](const spConfigSectionMemory &memory, const char* name) { return strcmp(memory.section.c_str(), name) < 0; });
+    if ((it == usage.sections.end()) || (it->section != section.first))
+    {
+      spConfigSectionMemory memory;
+      memory.section = section.first;
+      it = usage.sections.insert(it, memory);
+    }
+    size_t before = it->total();
+    it->values += section.second.size();
+    it->names += strlen(section.first) + 1;
+    it->index += sizeof(Sections::value_type) + SPCONFIG_MAPNODE_OVERHEAD;
+    for (const Keys::value_type &node : section.second)
+    {
+      const spConfigValue &value = node.second.value;
+      size_t used = value.m_buffer ? value.m_len + 1 : 0;
+      it->names += strlen(node.first) + 1;
+      it->text += used;
+      it->slack += textBytes(value) - used;
+      it->index += sizeof(Keys::value_type) + SPCONFIG_MAPNODE_OVERHEAD;
+    }
+    usage.total += it->total() - before;
+  }
+  usage.hashIndex += m_slots.size() * sizeof(Slot);
+  usage.total += m_slots.size() * sizeof(Slot);
+}
+
+/**
+ * @brief call the callback for each value in ascending order of section and key
+ * 
+ * @param callback  function called with section, key and value, returning false to stop
+ */
+void spConfigStore::forEach(std::function<bool(const char* section, const char* key, const spConfigValue &value)> callback) const
+{
+  for (const Sections::value_type &section : m_sections)
+  {
+    for (const Keys::value_type &node : section.second)
+    {
+      if (!callback(section.first, node.first, node.second.value))
+      {
+        return;
+      }
+    }
+  }
+}
+
+/**
+ * @brief call the callback for each section in ascending order
+ * 
+ * @param callback  function called with name of section, returning false to stop
+ */
+void spConfigStore::forEachSection(std::function<bool(const char* section)> callback) const
+{
+  for (const Sections::value_type &section : m_sections)
+  {
+    if (!callback(section.first))
+    {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief call the callback for each value of a section in ascending order of keys
+ * 
+ * @param section   name of section
+ * @param callback  function called with key and value, returning false to stop
+ */
+void spConfigStore::forEachInSection(const char* section, std::function<bool(const char* key, const spConfigValue &value)> callback) const
+{
+  auto sectionIt = m_sections.find(section ? section : "");
+  if (sectionIt == m_sections.end())
+  {
+    return;
+  }
+  for (const Keys::value_type &node : sectionIt->second)
+  {
+    if (!callback(node.first, node.second.value))
+    {
+      break;
+    }
+  }
+}
+
+
+
+/*    PRIVATE    PRIVATE    PRIVATE    PRIVATE
+
+      xxxxxxx   xxxxxxx      xx     xx    xx     xx     xxxxxxxx  xxxxxxxx
+      xx    xx  xx    xx     xx     xx    xx    xxxx       xx     xx      
+      xx    xx  xx    xx     xx     xx    xx   xx  xx      xx     xx      
+      xxxxxxx   xxxxxxx      xx      xx  xx   xx    xx     xx     xxxxxxx    
+      xx        xx    xx     xx      xx  xx   xxxxxxxx     xx     xx    
+      xx        xx    xx     xx       xxxx    xx    xx     xx     xx      
+      xx        xx    xx     xx        xx     xx    xx     xx     xxxxxxxx
+     
+
+      PRIVATE    PRIVATE    PRIVATE    PRIVATE    */
+
+
+/**
+ * @brief add a new entry, which is added to the index after taking all memory needed
+ * 
+ * @param key  section and key with hash
+ * @param value 
+ * @return spConfigValue*  pointer to value stored
+ */
+spConfigValue* spConfigStore::insert(const spConfigKey &key, const spConfigValue &value)
+{
+  const char* section = m_pNames->intern(key.section(), key.sectionLength());
+  const char* name = m_pNames->intern(key.key(), key.keyLength());
+  // keep load factor at or below 0.5
+  if ((m_count + 1) * 2 > m_slots.size())
+  {
+    grow();
+  }
+
+  // entry is created on its own and then moved into its section without further allocation
+  Keys keys(m_pResource);
+  Keys::iterator keyIt;
+  if (m_pArena || m_ownsText)
+  {
+    // value text in memory of the resource instead of a buffer of its own
+    keyIt = keys.emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple(key.hash())).first;
+    const char* text = value.c_str() ? value.c_str() : "";
+    size_t len = strlen(text);
+    keyIt->second.value.borrow(allocateText(text, len), len);
+  }
+  else
+  {
+    keyIt = keys.emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple(key.hash(), value)).first;
+  }
+
+  auto sectionIt = m_sections.find(section);
+  if (sectionIt == m_sections.end())
+  {
+    sectionIt = m_sections.emplace(section, std::move(keys)).first;
+    keyIt = sectionIt->second.begin();
+  }
+  else
+  {
+    keyIt = sectionIt->second.insert(keys.extract(keyIt)).position;
+  }
+  m_count++;
+  m_memoryUsed += entryBytes(*keyIt);
+  if (sectionIt->second.size() == 1)
+  {
+    m_memoryUsed += sectionBytes(*sectionIt);
+  }
+  insertSlot(Slot{ &*sectionIt, &*keyIt });
+  return &keyIt->second.value;
+}
+
+/**
+ * @brief copy text to memory of the resource
+ * 
+ * @param text 
+ * @param len  length of text
+ * @return char*  zero terminated copy of text
+ */
+char* spConfigStore::allocateText(const char* text, size_t len)
+{
+  char* buffer = static_cast<char*>(m_pResource->allocate(len + 1, 1));
+  memcpy(buffer, text, len);
+  buffer[len] = 0;
+  return buffer;
+}
+
+/**
+ * @brief replace the text of a value taken from the resource, in place when it fits
+ * 
+ * @param target  value stored
+ * @param value  new value
+ */
+void spConfigStore::setText(spConfigValue &target, const spConfigValue &value)
+{
+  const char* text = value.c_str() ? value.c_str() : "";
+  size_t len = strlen(text);
+  if (target.m_borrowed && (target.m_capacity >= len))
+  {
+    target = text;
+    return;
+  }
+  char* buffer = allocateText(text, len);
+  releaseText(target);
+  target.borrow(buffer, len);
+}
+
+/**
+ * @brief return the text of a value to the resource, unless it is released with the arena
+ * 
+ * @param value 
+ */
+void spConfigStore::releaseText(spConfigValue &value)
+{
+  if (m_ownsText && value.m_borrowed)
+  {
+    m_pResource->deallocate(value.m_buffer, value.m_capacity + 1, 1);
+    value.invalidate();
+  }
+}
+
+/**
+ * @brief return the texts of all values of a section to the resource
+ * 
+ * @param keys  entries of section
+ */
+void spConfigStore::releaseTexts(Keys &keys)
+{
+  if (!m_ownsText)
+  {
+    return;
+  }
+  for (Keys::value_type &node : keys)
+  {
+    releaseText(node.second.value);
+  }
+}
+
+/**
+ * @brief probe the hash table for section and key, comparing names only when the hash matches
+ * 
+ * @param key  section and key with hash
+ * @return size_t  index of slot with entry or of the free slot ending the probe
+ */
+size_t spConfigStore::findSlot(const spConfigKey &key) const
+{
+  size_t mask = m_slots.size() - 1;
+  size_t idx = key.hash() & mask;
+  while (m_slots[idx].pNode != nullptr)
+  {
+    const Slot &slot = m_slots[idx];
+    const char* section = slot.pSection->first;
+    const char* name = slot.pNode->first;
+    if ((slot.pNode->second.hash == key.hash()) &&
+        (strncmp(section, key.section(), key.sectionLength()) == 0) && (section[key.sectionLength()] == 0) &&
+        (strncmp(name, key.key(), key.keyLength()) == 0) && (name[key.keyLength()] == 0))
+    {
+      return idx;
+    }
+    idx = (idx + 1) & mask;
+  }
+  return idx;
+}
+
+/**
+ * @brief probe the hash table for the slot pointing to an entry
+ * 
+ * @param pNode  entry
+ * @return size_t  index of slot
+ */
+size_t spConfigStore::findSlot(const Keys::value_type* pNode) const
+{
+  size_t mask = m_slots.size() - 1;
+  size_t idx = pNode->second.hash & mask;
+  while ((m_slots[idx].pNode != pNode) && (m_slots[idx].pNode != nullptr))
+  {
+    idx = (idx + 1) & mask;
+  }
+  return idx;
+}
+
+/**
+ * @brief add entry to the first free slot for its hash
+ * 
+ * @param slot  pointers to section and entry
+ */
+void spConfigStore::insertSlot(const Slot &slot)
+{
+  size_t mask = m_slots.size() - 1;
+  size_t idx = slot.pNode->second.hash & mask;
+  while (m_slots[idx].pNode != nullptr)
+  {
+    idx = (idx + 1) & mask;
+  }
+  m_slots[idx] = slot;
+}
+
+/**
+ * @brief free a slot and move following entries of the probe sequence back, so no probe ends early
+ * 
+ * @param idx  index of slot
+ */
+void spConfigStore::eraseSlot(size_t idx)
+{
+  size_t mask = m_slots.size() - 1;
+  size_t hole = idx;
+  size_t next = idx;
+  while (true)
+  {
+    next = (next + 1) & mask;
+    if (m_slots[next].pNode == nullptr)
+    {
+      break;
+    }
+    // entry can fill the hole, unless its home slot lies cyclically within (hole, next]
+    size_t home = m_slots[next].pNode->second.hash & mask;
+    bool homeBetween = (hole < next) ? ((home > hole) && (home <= next)) : ((home > hole) || (home <= next));
+    if (!homeBetween)
+    {
+      m_slots[hole] = m_slots[next];
+      hole = next;
+    }
+  }
+  m_slots[hole] = Slot{ nullptr, nullptr };
+}
+
+/**
+ * @brief double the number of hash slots and re-insert all entries
+ * 
+ */
+void spConfigStore::grow()
+{
+  if (m_pArena)
+  {
+    m_arenaWaste += m_slots.size() * sizeof(Slot);
+  }
+  m_memoryUsed += m_slots.size() * sizeof(Slot);
+  m_slots.assign(m_slots.size() * 2, Slot{ nullptr, nullptr });
+  for (Sections::value_type &section : m_sections)
+  {
+    for (Keys::value_type &node : section.second)
+    {
+      insertSlot(Slot{ &section, &node });
+    }
+  }
+}
+
+/**
+ * @brief return the number of hash slots keeping the load factor at or below 0.5 for a capacity
+ * 
+ * @param capacity  maximum number of values or 0 for no limit
+ * @return size_t  number of slots, a power of 2
+ */
+size_t spConfigStore::slotsFor(size_t capacity)
+{
+  size_t slots = SPCONFIG_STORE_MINSLOTS;
+  while (slots < capacity * 2)
+  {
+    slots *= 2;
+  }
+  return slots;
+}
+
+/**
+ * @brief check whether adding or replacing a value keeps the memory used within the limit
+ * 
+ * @param key  section and key with hash
+ * @param oldBytes  bytes of text of the value replaced
+ * @param newBytes  bytes of text of the new value
+ * @param newEntry  true, if the value is added
+ * @return true / false  for change within limit
+ */
+bool spConfigStore::checkMemory(const spConfigKey &key, size_t oldBytes, size_t newBytes, bool newEntry)
+{
+  size_t needed = newBytes;
+  if (newEntry)
+  {
+    needed += sizeof(Keys::value_type) + SPCONFIG_MAPNODE_OVERHEAD + key.keyLength() + 1;
+    if (!hasSection(key))
+    {
+      needed += sizeof(Sections::value_type) + SPCONFIG_MAPNODE_OVERHEAD + key.sectionLength() + 1;
+    }
+    if ((m_count + 1) * 2 > m_slots.size())
+    {
+      needed += m_slots.size() * sizeof(Slot);
+    }
+  }
+  if (m_memoryUsed - oldBytes + needed > m_memoryLimit)
+  {
+    spLOGF_E("spConfigStore::set() failed for %.*s / %.*s, as the memory limit of %u bytes would be exceeded", (int)key.sectionLength(), key.section(), 
+             (int)key.keyLength(), key.key(), (unsigned int)m_memoryLimit);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief check whether the memory taken by adding or replacing a value fits into the fixed memory, 
+ *        following insert() and setText(), called with the fixed memory locked
+ * 
+ * @param key  section and key with hash
+ * @param pCurrent  value to be replaced or nullptr for a new entry
+ * @param text  new text or nullptr
+ * @return true / false  for change fitting
+ */
+bool spConfigStore::checkFixedMemory(const spConfigKey &key, const spConfigValue* pCurrent, const char* text)
+{
+  size_t sizes[SPCONFIG_FIXEDMEMORY_MAXFITS];
+  size_t count = 0;
+  size_t len = text ? strlen(text) : 0;
+  if (!pCurrent)
+  {
+    count = m_pNames->allocationsFor(key.section(), key.sectionLength(), key.key(), key.keyLength(), sizes);
+    sizes[count++] = sizeof(Keys::value_type) + SPCONFIG_MAPNODE_OVERHEAD;
+    if (!hasSection(key))
+    {
+      sizes[count++] = sizeof(Sections::value_type) + SPCONFIG_MAPNODE_OVERHEAD;
+    }
+  }
+  if (!pCurrent || !pCurrent->m_borrowed || (pCurrent->m_capacity < len))
+  {
+    sizes[count++] = len + 1;
+  }
+  if (!m_pFixed->fits(sizes, count))
+  {
+    spLOGF_E("spConfigStore::set() failed for %.*s / %.*s, as fixed memory is exhausted", (int)key.sectionLength(), key.section(), 
+             (int)key.keyLength(), key.key());
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief returns whether the section of a key holds values
+ * 
+ * @param key  section and key with hash
+ * @return true / false 
+ */
+bool spConfigStore::hasSection(const spConfigKey &key) const
+{
+  return m_sections.find(std::string_view(key.section(), key.sectionLength())) != m_sections.end();
+}
+
+/**
+ * @brief return the bytes a value will take after setting it to text, following setText() for text 
+ *        in the resource and spConfigValue::reserve() for buffers of values
+ * 
+ * @param pCurrent  value to be replaced or nullptr for a new entry
+ * @param text  new text or nullptr
+ * @return size_t 
+ */
+size_t spConfigStore::textBytesFor(const spConfigValue* pCurrent, const char* text) const
+{
+  size_t len = text ? strlen(text) : 0;
+  if (m_ownsText || (m_pArena && !pCurrent))
+  {
+    if (pCurrent && pCurrent->m_borrowed && (pCurrent->m_capacity >= len))
+    {
+      return textBytes(*pCurrent);
+    }
+    return len + 1;
+  }
+  if (!text)
+  {
+    return 0;
+  }
+  if (pCurrent && pCurrent->m_buffer && (pCurrent->m_capacity >= len))
+  {
+    return textBytes(*pCurrent);
+  }
+  return (len + 16) & (~0xf);
+}
+
+/**
+ * @brief return the bytes taken by the text buffer of a value
+ * 
+ * @param value 
+ * @return size_t 
+ */
+size_t spConfigStore::textBytes(const spConfigValue &value)
+{
+  return value.m_buffer ? value.m_capacity + 1 : 0;
+}
+
+/**
+ * @brief return the bytes of an entry with key name and text
+ * 
+ * @param node  entry
+ * @return size_t 
+ */
+size_t spConfigStore::entryBytes(const Keys::value_type &node)
+{
+  return sizeof(Keys::value_type) + SPCONFIG_MAPNODE_OVERHEAD + strlen(node.first) + 1 + textBytes(node.second.value);
+}
+
+/**
+ * @brief return the bytes of a section without its entries
+ * 
+ * @param section 
+ * @return size_t 
+ */
+size_t spConfigStore::sectionBytes(const Sections::value_type &section)
+{
+  return sizeof(Sections::value_type) + SPCONFIG_MAPNODE_OVERHEAD + strlen(section.first) + 1;
+}
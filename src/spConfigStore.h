@@ -0,0 +1,160 @@
+/**
+ * @file spConfigStore.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief class to store config values by section and key
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version replacing spObjectStore for hashed lookups
+ *          index of sections with their keys for enumeration and removal
+ *          section and key names interned in spConfigNamePool
+ *          optional arena for entries and values, released at once with the store
+ *          optional fixed capacity with entries, values and index in spConfigFixedMemory
+ *          memory usage by section and optional memory limit
+ * 
+ */
+
+
+#ifndef SPCONFIGSTORE_H
+#define SPCONFIGSTORE_H
+
+#include <stdint.h>
+#include <string>
+#include <string.h>
+#include <map>
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <functional>
+#include <string_view>
+
+#include <spConfigKey.h>
+#include <spConfigValue.h>
+#include <spConfigNamePool.h>
+#include <spConfigFixedMemory.h>
+
+
+// bytes of a map node in addition to its value, as used by common standard libraries
+#define SPCONFIG_MAPNODE_OVERHEAD  (4 * sizeof(void*))
+// bytes of the reference count of an object created by std::allocate_shared() in addition to the object
+#define SPCONFIG_SHARED_OVERHEAD  (4 * sizeof(void*))
+
+
+// estimated memory of the values of a section, with names counted for each use, although they are 
+// interned once in the name pool
+struct spConfigSectionMemory
+{
+  std::string section;
+  size_t values = 0;  // number of values
+  size_t names = 0;   // bytes of section and key names
+  size_t text = 0;    // bytes of value text including terminators
+  size_t slack = 0;   // bytes of value buffers not used by text
+  size_t index = 0;   // bytes of map nodes holding section and values
+  size_t total() const { return names + text + slack + index; }
+};
+
+// estimated memory of a config object, see spConfigBase::memoryUsage()
+struct spConfigMemoryUsage
+{
+  std::vector<spConfigSectionMemory> sections; // ordered by name, sections of all layers combined
+  size_t hashIndex = 0;  // bytes of hash tables of all layers
+  size_t namePool = 0;   // bytes taken by the name pool for all names held once
+  size_t total = 0;      // bytes of sections and hash tables
+  size_t budget = 0;     // memory budget or 0 for none
+  size_t budgetUsed = 0; // bytes of stored values and defaults counted against the budget
+};
+
+
+class spConfigStore
+{
+  private:
+    struct Entry
+    {
+      uint64_t hash;
+      spConfigValue value;
+      Entry(uint64_t hash, const spConfigValue &value) : hash(hash), value(value) {}
+      Entry(uint64_t hash) : hash(hash), value(static_cast<const char*>(nullptr)) {}
+    };
+    struct NameLess
+    {
+      using is_transparent = void; // finds names not null terminated without copying them
+      bool operator()(const char* name1, const char* name2) const { return strcmp(name1, name2) < 0; }
+      bool operator()(const char* name1, std::string_view name2) const { return name2.compare(name1) > 0; }
+      bool operator()(std::string_view name1, const char* name2) const { return name1.compare(name2) < 0; }
+    };
+    // two level index of sections and their keys in ascending order, nodes of maps keep their address
+    // names are pointers into the name pool
+    typedef std::pmr::map<const char*, Entry, NameLess> Keys;
+    typedef std::pmr::map<const char*, Keys, NameLess> Sections;
+    struct Slot
+    {
+      Sections::value_type* pSection;
+      Keys::value_type* pNode;
+    };
+    spConfigNamePoolPtr m_pNames;
+    // arena for map nodes and value text, declared before the maps to outlive them
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> m_pArena;
+    spConfigFixedMemory* m_pFixed = nullptr; // fixed memory checked before taking memory from it
+    // resource for maps, index and, with an upstream resource, for value text
+    std::pmr::memory_resource* m_pResource;
+    bool m_ownsText;
+    Sections m_sections;
+    size_t m_count = 0;
+    size_t m_capacity; // maximum number of values or 0 for no limit
+    size_t m_memoryUsed = 0; // estimated bytes of entries, text and hash table, see memoryUsage()
+    size_t m_memoryLimit = 0; // maximum of m_memoryUsed or 0 for no limit
+    size_t m_arenaWaste = 0; // estimated bytes of the arena no longer used
+    size_t m_minSlots;
+    // open addressing hash table with linear probing, pointing to entries
+    std::pmr::vector<Slot> m_slots;
+    //
+    spConfigValue* insert(const spConfigKey &key, const spConfigValue &value);
+    char* allocateText(const char* text, size_t len);
+    void setText(spConfigValue &target, const spConfigValue &value);
+    void releaseText(spConfigValue &value);
+    void releaseTexts(Keys &keys);
+    size_t findSlot(const spConfigKey &key) const;
+    size_t findSlot(const Keys::value_type* pNode) const;
+    void insertSlot(const Slot &slot);
+    void eraseSlot(size_t idx);
+    void grow();
+    static size_t slotsFor(size_t capacity);
+    bool checkMemory(const spConfigKey &key, size_t oldBytes, size_t newBytes, bool newEntry);
+    bool checkFixedMemory(const spConfigKey &key, const spConfigValue* pCurrent, const char* text);
+    bool hasSection(const spConfigKey &key) const;
+    size_t textBytesFor(const spConfigValue* pCurrent, const char* text) const;
+    static size_t textBytes(const spConfigValue &value);
+    static size_t entryBytes(const Keys::value_type &node);
+    static size_t sectionBytes(const Sections::value_type &section);
+
+  public:
+    spConfigStore(spConfigNamePoolPtr pNames = nullptr, std::pmr::memory_resource* pUpstream = nullptr);
+    spConfigStore(spConfigNamePoolPtr pNames, spConfigFixedMemory* pFixed, size_t capacity);
+    ~spConfigStore();
+    spConfigStore(const spConfigStore &store) = delete;
+    spConfigStore& operator =(const spConfigStore &store) = delete;
+    spConfigValue* find(const spConfigKey &key) const;
+    spConfigValue* set(const spConfigKey &key, const spConfigValue &value);
+    bool remove(const spConfigKey &key);
+    size_t removeSection(const char* section);
+    void reset();
+    size_t count() const;
+    size_t capacity() const;
+    static size_t indexBytes(size_t capacity);
+    spConfigNamePoolPtr getNamePool() const;
+    bool usesArena() const;
+    size_t arenaWaste() const;
+    size_t memoryUsed() const;
+    size_t getMemoryLimit() const;
+    void setMemoryLimit(size_t bytes);
+    void memoryUsage(spConfigMemoryUsage &usage) const;
+    void forEach(std::function<bool(const char* section, const char* key, const spConfigValue &value)> callback) const;
+    void forEachSection(std::function<bool(const char* section)> callback) const;
+    void forEachInSection(const char* section, std::function<bool(const char* key, const spConfigValue &value)> callback) const;
+
+};
+
+#endif // SPCONFIGSTORE_H
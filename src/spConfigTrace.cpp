@@ -0,0 +1,261 @@
+/**
+ * @file spConfigTrace.cpp
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief classes to trace the phases of reading and saving config files
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#include <spConfigTrace.h>
+#include <stdio.h>
+#include <chrono>
+
+
+/*    PUBLIC    PUBLIC    PUBLIC    PUBLIC    
+
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx      xxxxxx 
+      xx    xx  xx    xx  xx    xx  xx           xx     xx    xx
+      xx    xx  xx    xx  xx    xx  xx           xx     xx      
+      xxxxxxx   xx    xx  xxxxxxx   xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx      
+      xx        xx    xx  xx    xx  xx           xx     xx    xx
+      xx         xxxxxx   xxxxxxx   xxxxxxxx     xx      xxxxxx 
+     
+
+      PUBLIC    PUBLIC    PUBLIC    PUBLIC    */
+
+
+
+
+/**
+ * @brief set the function to receive trace events or nullptr to stop tracing, 
+ *        it is called while reading or saving and must not access the config object
+ * 
+ * @param callback  function receiving events or nullptr
+ */
+void spConfigTracer::setCallback(spConfigTraceCallback callback)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_callback = callback;
+  m_enabled.store((bool)m_callback, std::memory_order_relaxed);
+}
+
+/**
+ * @brief pass the event of a phase ending now to the callback
+ * 
+ * @param name  phase, a static string
+ * @param detail  name of file or nullptr
+ * @param startUS  start of phase from nowUS()
+ * @param bytes  bytes read, parsed or written
+ * @param values  values parsed
+ * @param insertUS  time spent adding parsed values to the store
+ */
+void spConfigTracer::emit(const char* name, const char* detail, uint64_t startUS, uint64_t bytes, uint64_t values, uint64_t insertUS)
+{
+  spConfigTraceEvent event;
+  event.name = name;
+  event.detail = detail ? detail : "";
+  event.startUS = startUS;
+  uint64_t endUS = nowUS();
+  event.durationUS = (endUS > startUS) ? endUS - startUS : 0;
+  event.bytes = bytes;
+  event.values = values;
+  event.insertUS = insertUS;
+  event.threadId = threadId();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_callback)
+  {
+    m_callback(event);
+  }
+}
+
+/**
+ * @brief return the time of the steady clock in microseconds
+ * 
+ * @return uint64_t 
+ */
+uint64_t spConfigTracer::nowUS()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief return a number for the calling thread, 1 for the first thread emitting events, 2 for the next one ...
+ * 
+ * @return uint64_t 
+ */
+uint64_t spConfigTracer::threadId()
+{
+  static std::atomic<uint64_t> s_nextId{1};
+  thread_local uint64_t t_id = s_nextId.fetch_add(1, std::memory_order_relaxed);
+  return t_id;
+}
+
+
+spConfigTraceScope::spConfigTraceScope(spConfigTracer &tracer, const char* name, const char* detail) : m_tracer(tracer), m_name(name)
+{
+  m_active = m_tracer.enabled();
+  if (m_active)
+  {
+    // copied, as a file name may change before the phase ends
+    if (detail)
+    {
+      m_detail = detail;
+    }
+    m_startUS = spConfigTracer::nowUS();
+  }
+}
+
+spConfigTraceScope::~spConfigTraceScope()
+{
+  if (m_active)
+  {
+    m_tracer.emit(m_name, m_detail.c_str(), m_startUS, bytes, values, insertUS);
+  }
+}
+
+
+/**
+ * @brief keep a copy of an event
+ * 
+ * @param event 
+ */
+void spConfigChromeTrace::add(const spConfigTraceEvent &event)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events.push_back(Event{event, event.detail});
+  m_events.back().event.detail = nullptr;
+}
+
+/**
+ * @brief return a callback adding events to this collector, e.g. for spConfigBase::setTraceCallback(), 
+ *        the collector must outlive its use
+ * 
+ * @return spConfigTraceCallback 
+ */
+spConfigTraceCallback spConfigChromeTrace::callback()
+{
+  return [this](const spConfigTraceEvent &event) { add(event); };
+}
+
+/**
+ * @brief return the number of events collected
+ * 
+ * @return size_t 
+ */
+size_t spConfigChromeTrace::count() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_events.size();
+}
+
+/**
+ * @brief remove all events collected
+ * 
+ */
+void spConfigChromeTrace::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events.clear();
+}
+
+/**
+ * @brief return the events in the Chrome trace event format as complete events, to be opened in 
+ *        chrome://tracing, Perfetto or other trace viewers
+ * 
+ * @return std::string  JSON object with array 'traceEvents'
+ */
+std::string spConfigChromeTrace::json() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::string text = "{\"traceEvents\":[";
+  char buf[256];
+  bool first = true;
+  for (const Event &e : m_events)
+  {
+    text.append(first ? "\n" : ",\n");
+    first = false;
+    text.append("{\"name\":\"");
+    appendEscaped(text, e.event.name);
+    snprintf(buf, sizeof(buf), "\",\"cat\":\"spConfig\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":1,\"tid\":%llu,\"args\":{\"bytes\":%llu,\"values\":%llu,\"insertUS\":%llu",
+             (unsigned long long)e.event.startUS, (unsigned long long)e.event.durationUS, (unsigned long long)e.event.threadId,
+             (unsigned long long)e.event.bytes, (unsigned long long)e.event.values, (unsigned long long)e.event.insertUS);
+    text.append(buf);
+    if (!e.detail.empty())
+    {
+      text.append(",\"file\":\"");
+      appendEscaped(text, e.detail.c_str());
+      text.append("\"");
+    }
+    text.append("}}");
+  }
+  text.append("\n],\"displayTimeUnit\":\"ms\"}\n");
+  return text;
+}
+
+/**
+ * @brief write the events as returned by json() to a file
+ * 
+ * @param filename  name of file with path
+ * @return true / false  for success
+ */
+bool spConfigChromeTrace::save(const char* filename) const
+{
+  std::string text = json();
+  FILE* pFile = fopen(filename, "wb");
+  if (!pFile)
+  {
+    return false;
+  }
+  bool success = fwrite(text.data(), 1, text.length(), pFile) == text.length();
+  return (fclose(pFile) == 0) && success;
+}
+
+
+
+/*    PRIVATE    PRIVATE    PRIVATE    PRIVATE
+
+      xxxxxxx   xxxxxxx      xx     xx    xx     xx     xxxxxxxx  xxxxxxxx
+      xx    xx  xx    xx     xx     xx    xx    xxxx       xx     xx      
+      xx    xx  xx    xx     xx     xx    xx   xx  xx      xx     xx      
+      xxxxxxx   xxxxxxx      xx      xx  xx   xx    xx     xx     xxxxxxx    
+      xx        xx    xx     xx      xx  xx   xxxxxxxx     xx     xx    
+      xx        xx    xx     xx       xxxx    xx    xx     xx     xx      
+      xx        xx    xx     xx        xx     xx    xx     xx     xxxxxxxx
+     
+
+      PRIVATE    PRIVATE    PRIVATE    PRIVATE    */
+
+
+
+/**
+ * @brief append a string with quotes, backslashes and control characters escaped for JSON
+ * 
+ * @param text  text to append to
+ * @param str  string to append
+ */
+void spConfigChromeTrace::appendEscaped(std::string &text, const char* str)
+{
+  for (const char* p = str; *p; p++)
+  {
+    unsigned char c = (unsigned char)*p;
+    if ((c == '"') || (c == '\\'))
+    {
+      text.push_back('\\');
+      text.push_back((char)c);
+    }
+    else if (c < 0x20)
+    {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", (unsigned int)c);
+      text.append(buf);
+    }
+    else
+    {
+      text.push_back((char)c);
+    }
+  }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file spConfigTrace.h
+ * @author krokoreit (krokoreit@gmail.com)
+ * @brief classes to trace the phases of reading and saving config files
+ * @version 2.2.0
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2024
+ * 
+ * Version history:
+ * v2.2.0   initial version with callback and Chrome trace event collector
+ * 
+ */
+
+
+#ifndef SPCONFIGTRACE_H
+#define SPCONFIGTRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <atomic>
+
+
+// phase of reading or saving, with times of the steady clock in microseconds
+struct spConfigTraceEvent
+{
+  const char* name = "";    // phase, e.g. "read", "parse", "parseChunk", "save" or "flush", a static string
+  const char* detail = "";  // name of file or "", only valid during the callback
+  uint64_t startUS = 0;
+  uint64_t durationUS = 0;
+  uint64_t bytes = 0;       // bytes read, parsed or written, 0 if not applicable
+  uint64_t values = 0;      // values parsed, 0 if not applicable
+  uint64_t insertUS = 0;    // part of the duration spent adding parsed values to the store
+  uint64_t threadId = 0;    // small number for each thread emitting events
+};
+
+typedef std::function<void(const spConfigTraceEvent &event)> spConfigTraceCallback;
+
+
+class spConfigTracer
+{
+  private:
+    std::mutex m_mutex; // guards callback, events are passed to it one at a time
+    spConfigTraceCallback m_callback;
+    std::atomic<bool> m_enabled{false};
+
+  public:
+    void setCallback(spConfigTraceCallback callback);
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void emit(const char* name, const char* detail, uint64_t startUS, uint64_t bytes = 0, uint64_t values = 0, uint64_t insertUS = 0);
+    static uint64_t nowUS();
+    static uint64_t threadId();
+
+};
+
+
+// emits the event of a phase when leaving the scope, if tracing was enabled when entering it
+class spConfigTraceScope
+{
+  private:
+    spConfigTracer &m_tracer;
+    const char* m_name;
+    std::string m_detail;
+    uint64_t m_startUS = 0;
+    bool m_active;
+
+  public:
+    uint64_t bytes = 0;
+    uint64_t values = 0;
+    uint64_t insertUS = 0;
+    spConfigTraceScope(spConfigTracer &tracer, const char* name, const char* detail = nullptr);
+    ~spConfigTraceScope();
+    spConfigTraceScope(const spConfigTraceScope &scope) = delete;
+    spConfigTraceScope& operator =(const spConfigTraceScope &scope) = delete;
+    bool active() const { return m_active; }
+
+};
+
+
+class spConfigChromeTrace
+{
+  private:
+    struct Event
+    {
+      spConfigTraceEvent event;
+      std::string detail;
+    };
+    mutable std::mutex m_mutex; // guards events
+    std::vector<Event> m_events;
+    static void appendEscaped(std::string &text, const char* str);
+
+  public:
+    void add(const spConfigTraceEvent &event);
+    spConfigTraceCallback callback();
+    size_t count() const;
+    void clear();
+    std::string json() const;
+    bool save(const char* filename) const;
+
+};
+
+#endif // SPCONFIGTRACE_H
@@ -2,8 +2,8 @@
  * @file spConfigValue.cpp
  * @author krokoreit (krokoreit@gmail.com)
  * @brief class to handle configuration data
- * @version 2.1.3
- * @date 2024-10-23
+ * @version 2.2.0
+ * @date 2026-10-18
  * @copyright Copyright (c) 2024
  * 
  */
@@ -418,6 +418,7 @@ inline void spConfigValue::init(void)
   m_buffer = nullptr;
   m_capacity = 0;
   m_len = 0;
+  m_borrowed = false;
 }
 
 /**
@@ -426,7 +427,7 @@ inline void spConfigValue::init(void)
  */
 void spConfigValue::invalidate(void)
 {
-  if(m_buffer)
+  if(m_buffer && !m_borrowed)
     free(m_buffer);
   init();
 }
@@ -452,10 +453,16 @@ bool spConfigValue::reserve(unsigned int size)
   }
 
   uint16_t oldLen = m_len;
-  char *newbuffer = (char *) realloc(m_buffer, newSize);
+  // a borrowed buffer is left to its arena and the value continues in a buffer of its own
+  char *newbuffer = m_borrowed ? (char *) malloc(newSize) : (char *) realloc(m_buffer, newSize);
   if (newbuffer)
   {
     size_t oldSize = m_capacity + 1; // include NULL.
+    if (m_borrowed)
+    {
+      memcpy(newbuffer, m_buffer, oldSize);
+      m_borrowed = false;
+    }
     if (newSize > oldSize)
     {
         memset(newbuffer + oldSize, 0, newSize - oldSize);
@@ -523,3 +530,19 @@ void spConfigValue::setBufferValue(const char *cstr)
     invalidate();
   }
 }
+
+/**
+ * @brief use a buffer allocated by the arena of a store, which holds the zero terminated value of 
+ *        length bytes and is released with the arena, so it is never freed or reallocated by the value
+ * 
+ * @param buffer 
+ * @param length 
+ */
+void spConfigValue::borrow(char *buffer, unsigned int length)
+{
+  invalidate();
+  m_buffer = buffer;
+  m_capacity = length;
+  m_len = length;
+  m_borrowed = true;
+}
@@ -2,8 +2,8 @@
  * @file spConfigValue.h
  * @author krokoreit (krokoreit@gmail.com)
  * @brief class to hold a config value
- * @version 2.1.3
- * @date 2024-10-23
+ * @version 2.2.0
+ * @date 2026-10-18
  * @copyright Copyright (c) 2024
  * 
  * Version history:
@@ -12,6 +12,7 @@
  * v2.0.1   replaced printf() with spLogHelper
  * v2.1.2   minor updates (aligned version with other files)
  * v2.1.3   align versioning
+ * v2.2.0   buffers borrowed from the arena or fixed memory of spConfigStore and the text buffer of spConfigFrozen
  * 
  */
 
@@ -27,17 +28,22 @@
 
 
 class spConfigValue{
+  friend class spConfigStore;
+  friend class spConfigFrozen;
+
 private:
   char* m_buffer;
   uint32_t m_capacity;
   uint32_t m_len;
   uint32_t m__decimalPlaces = 2;
+  bool m_borrowed; // buffer owned by the arena of a store, not to be freed
   void init(void);
   void invalidate(void);
   bool reserve(unsigned int size);
   void setLen(int len);
   void copy(const char *cstr, unsigned int length);
   void setBufferValue(const char *cstr);
+  void borrow(char *buffer, unsigned int length);
 
 public:
   spConfigValue(const char *cstr = "");
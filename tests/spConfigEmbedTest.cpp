@@ -0,0 +1,98 @@
+/**
+ * test for spConfig library
+ *
+ * compares the default values embedded by spconfig_embed_defaults() with the values
+ * read by spConfigBase::read() from the same file
+ *
+ */
+
+
+#include <filesystem>
+#include <spConfig.h>
+#include <embedDefaults.h>
+
+int failedChecks = 0;
+
+
+/**
+ * @brief print the result of a check
+ *
+ * @param ok  result
+ * @param text  what was checked
+ */
+void check(bool ok, const char* text)
+{
+  printf("   %s: %s\n", ok ? "ok    " : "FAILED", text);
+  if (!ok)
+  {
+    failedChecks++;
+  }
+}
+
+/**
+ * @brief check that all values of one config have the same value in the other
+ *
+ * @param from  config to take the values from
+ * @param to  config to compare with
+ * @param text  what is checked
+ * @return size_t  number of values compared
+ */
+size_t compareValues(spConfig &from, spConfig &to, const char* text)
+{
+  size_t count = 0;
+  bool same = true;
+  from.forEachSection([&](const char* section) {
+    from.forEachInSection(section, [&](const char* key, const spConfigValue &value) {
+      count++;
+      if (!to.exists(section, key) || (to.getString(section, key) != value.c_str()))
+      {
+        printf("   [%s] %s = '%s' differs\n", section, key, value.c_str());
+        same = false;
+      }
+      return true;
+    });
+    return true;
+  });
+  check(same, text);
+  return count;
+}
+
+
+/**
+ * @brief our main function
+ *
+ */
+int main(int argc, char *argv[])
+{
+  std::string a = argv[0];
+  printf("running %s\n", a.substr(a.rfind(std::filesystem::path::preferred_separator) + 1).c_str());
+  // ========================================================
+
+  spConfig fileConfig;
+  fileConfig.setConfigFilePath(SPCONFIG_TEST_DIR);
+  fileConfig.setConfigFilename("embedDefaults");
+  fileConfig.setConfigDefaultFilename("noDefaults");
+  check(fileConfig.read(), "file read");
+
+  spConfig embeddedConfig;
+  embeddedConfig.setDefaults(embedDefaults);
+
+  printf("compare:\n");
+  size_t fileValues = compareValues(fileConfig, embeddedConfig, "values read are embedded");
+  size_t embeddedValues = compareValues(embeddedConfig, fileConfig, "values embedded are read");
+  check((fileValues == embeddedValues) && (fileValues > 0), "same number of values");
+
+  printf("parsing:\n");
+  check(embeddedConfig.getInt32("net", "port") == 8080, "comment after value removed");
+  check(embeddedConfig.getString("net", "escaped") == "value", "escaped comment removed");
+  check(embeddedConfig.exists("net", "exactly99"), "line of maximum length kept");
+  check(!embeddedConfig.exists("net", "exactly100"), "line exceeding maximum length with its '\\r' skipped");
+  check(!embeddedConfig.exists("ui", "long"), "line exceeding maximum length skipped");
+  check(embeddedConfig.getInt32("ui", "size") == 12, "keys after skipped section line kept in previous section");
+  check(!embeddedConfig.exists("unclosed", "lost"), "unclosed section skipped");
+  check(embeddedConfig.getString("last", "value") == "without line end", "last line without line end");
+
+  // ========================================================
+  printf("done with %i failed checks\n", failedChecks);
+  return (failedChecks == 0) ? 0 : 1;
+}
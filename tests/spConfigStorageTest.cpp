@@ -0,0 +1,348 @@
+/**
+ * test for spConfig library
+ *
+ * reads and saves configuration files kept in an spConfigMemoryStorage, with failures and partial
+ * writes injected into the storage, so no file on disk is touched, and autosave driven by a clock
+ * set by the test instead of the loop task of spConfig
+ *
+ */
+
+
+#include <filesystem>
+#include <map>
+#include <spConfigBase.h>
+
+int failedChecks = 0;
+
+
+/**
+ * @brief config with a clock set by the test, autosave is scheduled like spConfig does it and
+ *        happens, when the test advances the clock past the scheduled time
+ *
+ */
+class ClockedConfig : public spConfigBase
+{
+  private:
+    uint64_t m_nowMS = 1000000;
+
+    void onSetChanged()
+    {
+      setNextAutosaveTimeMS(m_nowMS + 1500);
+    }
+
+  public:
+    /**
+     * @brief advance the clock and autosave, if due
+     *
+     * @param ms  milliseconds to advance
+     * @return true / false  for autosave done
+     */
+    bool advance(uint64_t ms)
+    {
+      m_nowMS += ms;
+      return autosaveIfDue(m_nowMS);
+    }
+};
+
+/**
+ * @brief config without storage, writing its files with saveFile() to a map, which fails while
+ *        failing is set, to check the path of a failed save without slots or storage
+ *
+ */
+class FileConfig : public spConfigBase
+{
+  private:
+    size_t readFile(std::string filename, char* buf, size_t startPos, size_t maxBytes)
+    {
+      auto it = files.find(filename);
+      if ((it == files.end()) || (startPos >= it->second.length()))
+      {
+        return 0;
+      }
+      return it->second.copy(buf, maxBytes, startPos);
+    }
+
+    size_t saveFile(std::string filename, char* buf, size_t startPos, size_t writeBytes)
+    {
+      if (failing)
+      {
+        return 0;
+      }
+      std::string &content = files[filename];
+      content.resize(startPos);
+      content.append(buf, writeBytes);
+      return writeBytes;
+    }
+
+  public:
+    std::map<std::string, std::string> files;
+    bool failing = false;
+};
+
+// storage before config, as it must outlive the config object
+spConfigMemoryStorage storage;
+ClockedConfig config;
+
+const char* configFile = "/mem/config.ini";
+const char* defaultFile = "/mem/config-default.ini";
+const char* slotFileA = "/mem/config.a.ini";
+const char* slotFileB = "/mem/config.b.ini";
+
+
+/**
+ * @brief print the result of a check
+ *
+ * @param ok  result
+ * @param text  what was checked
+ */
+void check(bool ok, const char* text)
+{
+  printf("   %s: %s\n", ok ? "ok    " : "FAILED", text);
+  if (!ok)
+  {
+    failedChecks++;
+  }
+}
+
+/**
+ * @brief return whether the file in the storage contains the text
+ *
+ * @param filename  name of file in storage
+ * @param text  text to find
+ */
+bool fileContains(const char* filename, const char* text)
+{
+  std::string content;
+  return storage.getFile(filename, content) && (content.find(text) != std::string::npos);
+}
+
+/**
+ * @brief replace the content of a file in the storage, as done by another process
+ *
+ * @param filename  name of file in storage
+ * @param content  new content
+ */
+void setFile(const char* filename, const char* content)
+{
+  storage.setFile(filename, content, strlen(content));
+}
+
+
+/**
+ * @brief parsing and saving
+ *
+ */
+void testRoundTrip()
+{
+  printf("parse:\n");
+  config.read();
+  check(config.getString("net", "host") == "localhost", "default value read");
+  check(config.getInt32("net", "port") == 9090, "value replacing default read, comment removed");
+  check(config.getString("ui", "theme") == "dark", "value without default read");
+
+  printf("save round trip:\n");
+  config.setValue("ui", "theme", "light");
+  config.save();
+  check(fileContains(configFile, "theme=light"), "changed value saved");
+  check(!fileContains(configFile, "host="), "default value not saved");
+  config.setValue("ui", "theme", "none");
+  config.read();
+  check(config.getString("ui", "theme") == "light", "saved value read again");
+}
+
+/**
+ * @brief failures of the storage
+ *
+ */
+void testErrors()
+{
+  printf("errors:\n");
+  storage.setFaults(SPCONFIG_FAULT_RENAME);
+  config.setValue("ui", "theme", "blue");
+  config.save();
+  check(fileContains(configFile, "theme=light"), "failed rename keeps previous file");
+  check(config.changed(), "values still changed after failed save");
+  storage.setFaults(0);
+  storage.setWriteLimit(10);
+  config.save();
+  storage.setWriteLimit(SIZE_MAX);
+  check(fileContains(configFile, "theme=light"), "partial write keeps previous file");
+  storage.setFaults(SPCONFIG_FAULT_OPENREAD);
+  config.read();
+  check(!config.exists("ui", "theme"), "unreadable file read like a missing one");
+  storage.setFaults(0);
+  config.setValue("ui", "theme", "blue");
+  config.save();
+  check(fileContains(configFile, "theme=blue"), "save succeeds again without faults");
+}
+
+/**
+ * @brief values changed but not saved survive reload(), while other values are taken from the file
+ *
+ */
+void testReloadMerge()
+{
+  printf("reload merging:\n");
+  setFile(configFile, "[net]\nport = 9090\n[ui]\ntheme = dark\nfont = small\n");
+  config.read();
+  config.setValue("ui", "theme", "local");
+  config.removeValue("ui", "font");
+  setFile(configFile, "[net]\nport = 7070\n[ui]\ntheme = remote\nfont = large\nsize = 12\n");
+  config.reload();
+  check(config.getString("ui", "theme") == "local", "unsaved change kept");
+  check(!config.exists("ui", "font"), "unsaved removal kept");
+  check(config.getInt32("net", "port") == 7070, "changed value taken from file");
+  check(config.getInt32("ui", "size") == 12, "new value taken from file");
+  config.save();
+  check(fileContains(configFile, "theme=local") && !fileContains(configFile, "font="), "kept changes saved");
+  config.reload();
+  check(!config.changed(), "nothing changed after saving");
+}
+
+/**
+ * @brief values not written by a failed save are kept by reload() and written by the next save
+ *
+ */
+void testFailedSaveReload()
+{
+  printf("reload after failed save:\n");
+  setFile(configFile, "[ui]\ntheme = dark\n");
+  config.read();
+  config.setValue("ui", "theme", "unsaved");
+  storage.setFaults(SPCONFIG_FAULT_WRITE);
+  config.save();
+  storage.setFaults(0);
+  check(config.changed(), "values still changed after failed write");
+  setFile(configFile, "[ui]\ntheme = remote\nfont = large\n");
+  config.reload();
+  check(config.getString("ui", "theme") == "unsaved", "value not saved kept by reload");
+  check(config.getString("ui", "font") == "large", "other value taken from file");
+  config.save();
+  check(fileContains(configFile, "theme=unsaved") && fileContains(configFile, "font=large"), "value saved by next save");
+  check(!config.changed(), "nothing changed after saving");
+}
+
+/**
+ * @brief the same without storage, where a failed save may have left a damaged file behind
+ *
+ */
+void testFailedSaveReloadWithoutStorage()
+{
+  printf("reload after failed save without storage:\n");
+  FileConfig fileConfig;
+  fileConfig.setStorage(nullptr); // also when built with SPCONFIG_STORAGE
+  fileConfig.setConfigFilePath("/mem");
+  std::string filename = std::string("/mem") + std::filesystem::path::preferred_separator + "config.ini";
+  fileConfig.files[filename] = "[ui]\ntheme = dark\n";
+  fileConfig.read();
+  fileConfig.setValue("ui", "theme", "unsaved");
+  fileConfig.failing = true;
+  fileConfig.save();
+  fileConfig.failing = false;
+  check(fileConfig.changed(), "values still changed after failed save");
+  fileConfig.files[filename] = "[ui]\ntheme = remote\n";
+  fileConfig.reload();
+  check(fileConfig.getString("ui", "theme") == "unsaved", "value not saved kept by reload");
+  fileConfig.save();
+  check(fileConfig.files[filename].find("theme=unsaved") != std::string::npos, "value saved by next save");
+}
+
+/**
+ * @brief slot mode falls back to the previous slot, when the newer one is incomplete or damaged
+ *
+ */
+void testSlotFallback()
+{
+  printf("slot mode:\n");
+  setFile(configFile, "[ui]\ntheme = dark\n");
+  config.setSlotMode(true);
+  config.read();
+  check(config.getString("ui", "theme") == "dark", "config file read without slots");
+  config.setValue("ui", "theme", "first");
+  config.save();
+  config.setValue("ui", "theme", "second");
+  config.save();
+  check(fileContains(slotFileA, "theme=first") && fileContains(slotFileB, "theme=second"), "saves alternate between slots");
+  config.read();
+  check(config.getString("ui", "theme") == "second", "newer slot read");
+
+  storage.setWriteLimit(20);
+  config.setValue("ui", "theme", "third");
+  config.save();
+  storage.setWriteLimit(SIZE_MAX);
+  check(fileContains(slotFileB, "theme=second"), "partial write leaves newer slot intact");
+  config.read();
+  check(config.getString("ui", "theme") == "second", "newer slot read after partial write");
+
+  std::string content;
+  storage.getFile(slotFileB, content);
+  content.replace(content.find("second"), 6, "damage");
+  storage.setFile(slotFileB, content.c_str(), content.length());
+  config.read();
+  check(config.getString("ui", "theme") == "first", "damaged slot falls back to previous slot");
+  config.setValue("ui", "theme", "fourth");
+  config.save();
+  check(fileContains(slotFileB, "theme=fourth"), "save replaces damaged slot");
+  config.read();
+  check(config.getString("ui", "theme") == "fourth", "repaired slot read");
+  config.setSlotMode(false);
+}
+
+/**
+ * @brief autosave after the delay following the last change, retried after a failed save
+ *
+ */
+void testAutosave()
+{
+  printf("autosave:\n");
+  setFile(configFile, "[ui]\ntheme = dark\n");
+  config.read();
+  config.setAutosave(true);
+  config.setValue("ui", "theme", "green");
+  check(!config.advance(1000), "no autosave before delay");
+  config.setValue("ui", "font", "small");
+  check(!config.advance(1000), "delay restarted by further change");
+  check(config.advance(600), "autosave after delay");
+  check(fileContains(configFile, "theme=green") && fileContains(configFile, "font=small"), "values saved by autosave");
+  check(!config.advance(5000), "no autosave without changes");
+
+  storage.setLatency(1000, 20000);
+  storage.setFaults(SPCONFIG_FAULT_SYNC);
+  config.setValue("ui", "theme", "slow");
+  check(config.advance(2000), "autosave with slow storage");
+  check(!fileContains(configFile, "theme=slow") && config.changed(), "failed autosave keeps values changed");
+  storage.setFaults(0);
+  check(config.advance(1000), "autosave retried");
+  check(fileContains(configFile, "theme=slow") && !config.changed(), "value saved by retried autosave");
+  storage.setLatency(0, 0);
+  config.setAutosave(false);
+}
+
+
+/**
+ * @brief our main function
+ *
+ */
+int main(int argc, char *argv[])
+{
+  std::string a = argv[0];
+  printf("running %s\n", a.substr(a.rfind(std::filesystem::path::preferred_separator) + 1).c_str());
+  // ========================================================
+
+  setFile(defaultFile, "[net]\nhost = localhost\nport = 8080\n");
+  setFile(configFile, "; values\n[net]\nport = 9090 # not the default\n[ui]\ntheme=dark\n");
+  config.setStorage(&storage);
+  config.setConfigFilePath("/mem");
+
+  testRoundTrip();
+  testErrors();
+  testReloadMerge();
+  testFailedSaveReload();
+  testFailedSaveReloadWithoutStorage();
+  testSlotFallback();
+  testAutosave();
+
+  // ========================================================
+  printf("done with %i failed checks\n", failedChecks);
+  return (failedChecks == 0) ? 0 : 1;
+}